@@ -0,0 +1,14 @@
+#version 460 core
+
+in vec3 vColor;
+
+layout (location = 1) uniform vec3 objectColor;
+layout (location = 2) uniform bool useVertexColor;
+
+out vec4 FragColor;
+
+void main()
+{
+    vec3 finalColor = useVertexColor ? vColor : objectColor;
+    FragColor = vec4(finalColor, 1.0);
+}
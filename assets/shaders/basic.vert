@@ -0,0 +1,21 @@
+#version 460 core
+
+layout (location = 0) in vec3 aPosition;
+layout (location = 1) in vec3 aColor;
+
+layout (std140) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+};
+
+// explicit helyek: a UniformHandle-ök újratöltés után is érvényesek
+layout (location = 0) uniform mat4 model;
+
+out vec3 vColor;
+
+void main()
+{
+    vColor = aColor;
+    gl_Position = projection * view * model * vec4(aPosition, 1.0);
+}
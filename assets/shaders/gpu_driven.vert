@@ -0,0 +1,41 @@
+#version 460 core
+
+// GPU-driven rajzolás: a példány a gl_DrawID szerinti draw data és a
+// gl_InstanceID alapján az SSBO-ból jön (GpuDrivenRenderer)
+
+layout (location = 0) in vec3 aPosition;
+layout (location = 1) in vec3 aColor;
+
+layout (std140) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+};
+
+struct InstanceData
+{
+    mat4 model;
+    vec4 color;
+};
+
+layout (std430, binding = 0) readonly buffer Instances
+{
+    InstanceData instances[];
+};
+
+layout (std430, binding = 1) readonly buffer DrawData
+{
+    uint drawFirstInstance[];
+};
+
+out vec3 vColor;
+flat out vec4 vInstanceColor;
+
+void main()
+{
+    InstanceData instance = instances[drawFirstInstance[gl_DrawID] + gl_InstanceID];
+
+    vColor = aColor;
+    vInstanceColor = instance.color;
+    gl_Position = projection * view * instance.model * vec4(aPosition, 1.0);
+}
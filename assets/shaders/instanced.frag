@@ -0,0 +1,12 @@
+#version 460 core
+
+in vec3 vColor;
+flat in vec4 vInstanceColor;
+
+out vec4 FragColor;
+
+void main()
+{
+    vec3 finalColor = vInstanceColor.w > 0.5 ? vColor : vInstanceColor.rgb;
+    FragColor = vec4(finalColor, 1.0);
+}
@@ -0,0 +1,24 @@
+#version 460 core
+
+// Példányosított rajzolás: a model mátrix és a szín az instance bufferből jön
+
+layout (location = 0) in vec3 aPosition;
+layout (location = 1) in vec3 aColor;
+layout (location = 2) in mat4 aModel;
+layout (location = 6) in vec4 aInstanceColor;
+
+layout (std140) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+};
+
+out vec3 vColor;
+flat out vec4 vInstanceColor;
+
+void main()
+{
+    vColor = aColor;
+    vInstanceColor = aInstanceColor;
+    gl_Position = projection * view * aModel * vec4(aPosition, 1.0);
+}
@@ -1,15 +1,61 @@
 #include "AABB.h"
 #include "Entity.h"
 
+#include <algorithm>
+
 AABB ComputeWorldAABB(const Entity& entity)
 {
     const CollisionShape& c = entity.collision;
 
     glm::vec3 center = entity.transform.position + c.localOffset;
 
-    return
+    switch (c.type)
+    {
+    case CollisionShape::Type::Sphere:
+        return
+        {
+            center - glm::vec3(c.radius),
+            center + glm::vec3(c.radius)
+        };
+
+    case CollisionShape::Type::Capsule:
+    {
+        // a kapszula alja a pozíciónál van, lásd CharacterController::ComputeCapsule
+        const float radius = c.capsule.radius;
+        const float height = std::max(c.capsule.height, 2.0f * radius);
+
+        return
+        {
+            center - glm::vec3(radius, 0.0f, radius),
+            center + glm::vec3(radius, height, radius)
+        };
+    }
+
+    case CollisionShape::Type::OBB:
+        return ComputeOBBBounds(ComputeWorldOBB(entity));
+
+    default:
+        return
+        {
+            center - c.halfExtents,
+            center + c.halfExtents
+        };
+    }
+}
+
+const AABB& GetWorldAABB(const Entity& entity)
+{
+    if (entity.worldAABBDirty)
     {
-        center - c.halfExtents,
-        center + c.halfExtents
-    };
+        entity.cachedWorldAABB = ComputeWorldAABB(entity);
+        entity.worldAABBDirty = false;
+    }
+
+    return entity.cachedWorldAABB;
+}
+
+void MarkTransformDirty(Entity& entity)
+{
+    entity.worldAABBDirty = true;
+    entity.worldOBBDirty = true;
 }
\ No newline at end of file
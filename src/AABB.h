@@ -10,4 +10,11 @@ struct AABB
     glm::vec3 max;
 };
 
-AABB ComputeWorldAABB(const Entity& entity);
\ No newline at end of file
+// Mindig jraszmol a Transform s a CollisionShape alapjn
+AABB ComputeWorldAABB(const Entity& entity);
+
+// Gyorsttrazott vltozat: csak MarkTransformDirty utn szmol jra
+const AABB& GetWorldAABB(const Entity& entity);
+
+// A Transform vagy a CollisionShape megvltozsa utn hvand
+void MarkTransformDirty(Entity& entity);
\ No newline at end of file
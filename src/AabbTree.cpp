@@ -0,0 +1,424 @@
+#include "AabbTree.h"
+
+#include <algorithm>
+#include <cmath>
+
+AABB AabbTree::Union(const AABB& a, const AABB& b)
+{
+    return
+    {
+        glm::vec3(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)),
+        glm::vec3(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z))
+    };
+}
+
+float AabbTree::SurfaceArea(const AABB& box)
+{
+    glm::vec3 d = box.max - box.min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+bool AabbTree::Contains(const AABB& outer, const AABB& inner)
+{
+    return
+        outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+        inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+}
+
+bool AabbTree::RayIntersectsAABB(
+    const glm::vec3& origin,
+    const glm::vec3& inverseDirection,
+    float maxDistance,
+    const AABB& box,
+    float& outEntry)
+{
+    float tMin = 0.0f;
+    float tMax = maxDistance;
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (std::isinf(inverseDirection[axis]))
+        {
+            // párhuzamos a slabbel: csak akkor talál, ha benne indul
+            if (origin[axis] < box.min[axis] || origin[axis] > box.max[axis])
+                return false;
+
+            continue;
+        }
+
+        float t1 = (box.min[axis] - origin[axis]) * inverseDirection[axis];
+        float t2 = (box.max[axis] - origin[axis]) * inverseDirection[axis];
+
+        if (t1 > t2)
+            std::swap(t1, t2);
+
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+
+        if (tMin > tMax)
+            return false;
+    }
+
+    outEntry = tMin;
+    return true;
+}
+
+int AabbTree::AllocateNode()
+{
+    if (freeList == NullNode)
+    {
+        nodes.emplace_back();
+        freeList = static_cast<int>(nodes.size()) - 1;
+        nodes[freeList].parent = NullNode;
+    }
+
+    int nodeId = freeList;
+    freeList = nodes[nodeId].parent;
+
+    Node& node = nodes[nodeId];
+    node.parent = NullNode;
+    node.child1 = NullNode;
+    node.child2 = NullNode;
+    node.height = 0;
+    node.entity = nullptr;
+
+    return nodeId;
+}
+
+void AabbTree::FreeNode(int nodeId)
+{
+    nodes[nodeId].parent = freeList;
+    nodes[nodeId].height = -1;
+    nodes[nodeId].entity = nullptr;
+    freeList = nodeId;
+}
+
+int AabbTree::CreateProxy(Entity* entity, const AABB& bounds)
+{
+    int proxyId = AllocateNode();
+
+    Node& node = nodes[proxyId];
+    node.tightBounds = bounds;
+    node.fatBounds = { bounds.min - glm::vec3(FatMargin), bounds.max + glm::vec3(FatMargin) };
+    node.entity = entity;
+    node.height = 0;
+
+    InsertLeaf(proxyId);
+    ++proxyCount;
+
+    return proxyId;
+}
+
+void AabbTree::DestroyProxy(int proxyId)
+{
+    RemoveLeaf(proxyId);
+    FreeNode(proxyId);
+    --proxyCount;
+}
+
+bool AabbTree::MoveProxy(int proxyId, const AABB& bounds)
+{
+    Node& node = nodes[proxyId];
+
+    const glm::vec3 displacement =
+        (bounds.min + bounds.max) * 0.5f - (node.tightBounds.min + node.tightBounds.max) * 0.5f;
+
+    node.tightBounds = bounds;
+
+    // amíg a fat dobozon belül marad, a fa szerkezete változatlan
+    if (Contains(node.fatBounds, bounds))
+        return false;
+
+    RemoveLeaf(proxyId);
+
+    // a mozgás irányába előre megnöveljük a dobozt
+    AABB fat = { bounds.min - glm::vec3(FatMargin), bounds.max + glm::vec3(FatMargin) };
+    glm::vec3 predicted = displacement * DisplacementMultiplier;
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (predicted[axis] < 0.0f)
+            fat.min[axis] += predicted[axis];
+        else
+            fat.max[axis] += predicted[axis];
+    }
+
+    nodes[proxyId].fatBounds = fat;
+
+    InsertLeaf(proxyId);
+    return true;
+}
+
+void AabbTree::Clear()
+{
+    nodes.clear();
+    root = NullNode;
+    freeList = NullNode;
+    proxyCount = 0;
+}
+
+Entity* AabbTree::GetEntity(int proxyId) const
+{
+    return nodes[proxyId].entity;
+}
+
+const AABB& AabbTree::GetFatAABB(int proxyId) const
+{
+    return nodes[proxyId].fatBounds;
+}
+
+const AABB& AabbTree::GetTightAABB(int proxyId) const
+{
+    return nodes[proxyId].tightBounds;
+}
+
+int AabbTree::GetHeight() const
+{
+    return root == NullNode ? 0 : nodes[root].height;
+}
+
+int AabbTree::GetProxyCount() const
+{
+    return proxyCount;
+}
+
+void AabbTree::InsertLeaf(int leaf)
+{
+    if (root == NullNode)
+    {
+        root = leaf;
+        nodes[root].parent = NullNode;
+        return;
+    }
+
+    // Testvér keresése felületi heurisztikával (SAH)
+    const AABB leafBounds = nodes[leaf].fatBounds;
+    int index = root;
+
+    while (!nodes[index].IsLeaf())
+    {
+        const Node& node = nodes[index];
+        const int child1 = node.child1;
+        const int child2 = node.child2;
+
+        const float area = SurfaceArea(node.fatBounds);
+        const float combinedArea = SurfaceArea(Union(node.fatBounds, leafBounds));
+
+        // új szülő létrehozásának költsége itt
+        const float cost = 2.0f * combinedArea;
+
+        // a levél lejjebb tolásának minimális költsége
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto DescendCost = [&](int child)
+        {
+            const AABB merged = Union(leafBounds, nodes[child].fatBounds);
+
+            if (nodes[child].IsLeaf())
+                return SurfaceArea(merged) + inheritanceCost;
+
+            return SurfaceArea(merged) - SurfaceArea(nodes[child].fatBounds) + inheritanceCost;
+        };
+
+        const float cost1 = DescendCost(child1);
+        const float cost2 = DescendCost(child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        index = cost1 < cost2 ? child1 : child2;
+    }
+
+    const int sibling = index;
+
+    // Új szülő
+    const int oldParent = nodes[sibling].parent;
+    const int newParent = AllocateNode();
+
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].fatBounds = Union(leafBounds, nodes[sibling].fatBounds);
+    nodes[newParent].height = nodes[sibling].height + 1;
+
+    if (oldParent != NullNode)
+    {
+        if (nodes[oldParent].child1 == sibling)
+            nodes[oldParent].child1 = newParent;
+        else
+            nodes[oldParent].child2 = newParent;
+    }
+    else
+    {
+        root = newParent;
+    }
+
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    // Visszafelé a gyökérig: magasság és doboz frissítése, forgatás
+    index = nodes[leaf].parent;
+    while (index != NullNode)
+    {
+        index = Balance(index);
+
+        const int child1 = nodes[index].child1;
+        const int child2 = nodes[index].child2;
+
+        nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+        nodes[index].fatBounds = Union(nodes[child1].fatBounds, nodes[child2].fatBounds);
+
+        index = nodes[index].parent;
+    }
+}
+
+void AabbTree::RemoveLeaf(int leaf)
+{
+    if (leaf == root)
+    {
+        root = NullNode;
+        return;
+    }
+
+    const int parent = nodes[leaf].parent;
+    const int grandParent = nodes[parent].parent;
+    const int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent == NullNode)
+    {
+        root = sibling;
+        nodes[sibling].parent = NullNode;
+        FreeNode(parent);
+        return;
+    }
+
+    // A szülőt töröljük, a testvér a helyére lép
+    if (nodes[grandParent].child1 == parent)
+        nodes[grandParent].child1 = sibling;
+    else
+        nodes[grandParent].child2 = sibling;
+
+    nodes[sibling].parent = grandParent;
+    FreeNode(parent);
+
+    int index = grandParent;
+    while (index != NullNode)
+    {
+        index = Balance(index);
+
+        const int child1 = nodes[index].child1;
+        const int child2 = nodes[index].child2;
+
+        nodes[index].fatBounds = Union(nodes[child1].fatBounds, nodes[child2].fatBounds);
+        nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+
+        index = nodes[index].parent;
+    }
+}
+
+// Ha az A csomópont kiegyensúlyozatlan, balra vagy jobbra forgatunk.
+// Visszaadja az új részfa gyökerét.
+int AabbTree::Balance(int iA)
+{
+    Node& A = nodes[iA];
+
+    if (A.IsLeaf() || A.height < 2)
+        return iA;
+
+    const int iB = A.child1;
+    const int iC = A.child2;
+
+    const int balance = nodes[iC].height - nodes[iB].height;
+
+    // C felfelé forgatása
+    if (balance > 1)
+    {
+        const int iF = nodes[iC].child1;
+        const int iG = nodes[iC].child2;
+
+        nodes[iC].child1 = iA;
+        nodes[iC].parent = A.parent;
+        A.parent = iC;
+
+        if (nodes[iC].parent != NullNode)
+        {
+            if (nodes[nodes[iC].parent].child1 == iA)
+                nodes[nodes[iC].parent].child1 = iC;
+            else
+                nodes[nodes[iC].parent].child2 = iC;
+        }
+        else
+        {
+            root = iC;
+        }
+
+        if (nodes[iF].height > nodes[iG].height)
+        {
+            nodes[iC].child2 = iF;
+            A.child2 = iG;
+            nodes[iG].parent = iA;
+        }
+        else
+        {
+            nodes[iC].child2 = iG;
+            A.child2 = iF;
+            nodes[iF].parent = iA;
+        }
+
+        A.fatBounds = Union(nodes[iB].fatBounds, nodes[A.child2].fatBounds);
+        A.height = 1 + std::max(nodes[iB].height, nodes[A.child2].height);
+
+        const int iOther = nodes[iC].child2;
+        nodes[iC].fatBounds = Union(A.fatBounds, nodes[iOther].fatBounds);
+        nodes[iC].height = 1 + std::max(A.height, nodes[iOther].height);
+
+        return iC;
+    }
+
+    // B felfelé forgatása
+    if (balance < -1)
+    {
+        const int iD = nodes[iB].child1;
+        const int iE = nodes[iB].child2;
+
+        nodes[iB].child1 = iA;
+        nodes[iB].parent = A.parent;
+        A.parent = iB;
+
+        if (nodes[iB].parent != NullNode)
+        {
+            if (nodes[nodes[iB].parent].child1 == iA)
+                nodes[nodes[iB].parent].child1 = iB;
+            else
+                nodes[nodes[iB].parent].child2 = iB;
+        }
+        else
+        {
+            root = iB;
+        }
+
+        if (nodes[iD].height > nodes[iE].height)
+        {
+            nodes[iB].child2 = iD;
+            A.child1 = iE;
+            nodes[iE].parent = iA;
+        }
+        else
+        {
+            nodes[iB].child2 = iE;
+            A.child1 = iD;
+            nodes[iD].parent = iA;
+        }
+
+        A.fatBounds = Union(nodes[iC].fatBounds, nodes[A.child1].fatBounds);
+        A.height = 1 + std::max(nodes[iC].height, nodes[A.child1].height);
+
+        const int iOther = nodes[iB].child2;
+        nodes[iB].fatBounds = Union(A.fatBounds, nodes[iOther].fatBounds);
+        nodes[iB].height = 1 + std::max(A.height, nodes[iOther].height);
+
+        return iB;
+    }
+
+    return iA;
+}
\ No newline at end of file
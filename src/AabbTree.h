@@ -0,0 +1,299 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/vec3.hpp>
+#include "AABB.h"
+#include "CollisionBatch.h"
+#include "PlayerCollision.h"
+
+struct Entity;
+
+// Dinamikus AABB fa (BVH). A levelek "hízlalt" (fat) dobozt tárolnak, így egy
+// mozgó entitást csak akkor kell újra beszúrni, ha kilép ebből a dobozból.
+// A fát forgatásokkal tartjuk kiegyensúlyozva.
+class AabbTree
+{
+public:
+    static constexpr int NullNode = -1;
+
+    int CreateProxy(Entity* entity, const AABB& bounds);
+    void DestroyProxy(int proxyId);
+
+    // true, ha a levelet újra kellett szúrni
+    bool MoveProxy(int proxyId, const AABB& bounds);
+
+    void Clear();
+
+    Entity* GetEntity(int proxyId) const;
+    const AABB& GetFatAABB(int proxyId) const;
+    const AABB& GetTightAABB(int proxyId) const;
+
+    int GetHeight() const;
+    int GetProxyCount() const;
+
+    // bool callback(Entity* entity, const AABB& bounds), false -> leállás
+    template <typename Callback>
+    void QueryAABB(const AABB& box, Callback&& callback) const;
+
+    // float callback(Entity* entity, const AABB& bounds, float entryDistance)
+    // A visszatérési érték az új maximális távolság (levágás), 0 -> leállás.
+    template <typename Callback>
+    void RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const;
+
+    // Sugárcsomag bejárása: a csomópontokat egyszerre teszteli az összes aktív
+    // sugárral, a részfába csak a dobozt metsző sugarak mennek tovább.
+    // void callback(Entity* entity, const AABB& bounds, std::uint32_t rayMask),
+    // a callback a packet.maxDistance csökkentésével vághatja a sugarakat.
+    template <typename Callback>
+    void RayCastPacket(RayPacket& packet, std::uint32_t activeMask, Callback&& callback) const;
+
+    // Egy AABB-vel közelített alakzat (gömb, kapszula) söprése displacement mentén.
+    // bool callback(Entity* entity, const AABB& bounds), false -> leállás
+    template <typename Callback>
+    void QuerySwept(const AABB& shapeBounds, const glm::vec3& displacement, Callback&& callback) const;
+
+private:
+    static constexpr float FatMargin = 0.1f;
+    static constexpr float DisplacementMultiplier = 2.0f;
+    static constexpr int MaxStackSize = 128;
+
+    // Bejárási verem: az első MaxStackSize elem a veremkereten van, a ritka
+    // mély fáknál a többi a heapre kerül, így egy részfa sem marad ki.
+    template <typename T>
+    class TraversalStack
+    {
+    public:
+        void Push(const T& value)
+        {
+            if (size < MaxStackSize)
+                items[size] = value;
+            else
+                overflow.push_back(value);
+
+            ++size;
+        }
+
+        T Pop()
+        {
+            --size;
+
+            if (size < MaxStackSize)
+                return items[size];
+
+            const T value = overflow.back();
+            overflow.pop_back();
+            return value;
+        }
+
+        bool IsEmpty() const
+        {
+            return size == 0;
+        }
+
+    private:
+        T items[MaxStackSize];
+        std::vector<T> overflow;
+        int size = 0;
+    };
+
+    struct Node
+    {
+        AABB fatBounds{};
+        AABB tightBounds{};
+        Entity* entity = nullptr;
+
+        int parent = NullNode; // szabad listában a következő szabad elem
+        int child1 = NullNode;
+        int child2 = NullNode;
+
+        int height = -1; // levél: 0, szabad: -1
+
+        bool IsLeaf() const
+        {
+            return child1 == NullNode;
+        }
+    };
+
+    int AllocateNode();
+    void FreeNode(int nodeId);
+
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    int Balance(int nodeId);
+
+    static AABB Union(const AABB& a, const AABB& b);
+    static float SurfaceArea(const AABB& box);
+    static bool Contains(const AABB& outer, const AABB& inner);
+
+    // slab teszt, a [0, maxDistance] szakaszon belüli belépési távolsággal
+    static bool RayIntersectsAABB(
+        const glm::vec3& origin,
+        const glm::vec3& inverseDirection,
+        float maxDistance,
+        const AABB& box,
+        float& outEntry);
+
+private:
+    std::vector<Node> nodes;
+    int root = NullNode;
+    int freeList = NullNode;
+    int proxyCount = 0;
+};
+
+template <typename Callback>
+void AabbTree::QueryAABB(const AABB& box, Callback&& callback) const
+{
+    if (root == NullNode)
+        return;
+
+    TraversalStack<int> stack;
+    stack.Push(root);
+
+    while (!stack.IsEmpty())
+    {
+        const Node& node = nodes[stack.Pop()];
+
+        if (!IntersectAABBvsAABB(node.fatBounds, box))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            if (!IntersectAABBvsAABB(node.tightBounds, box))
+                continue;
+
+            if (!callback(node.entity, node.tightBounds))
+                return;
+        }
+        else
+        {
+            stack.Push(node.child1);
+            stack.Push(node.child2);
+        }
+    }
+}
+
+template <typename Callback>
+void AabbTree::RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const
+{
+    if (root == NullNode)
+        return;
+
+    // 0 komponensnél a végtelen a slab tesztben helyesen viselkedik
+    const glm::vec3 inverseDirection = 1.0f / direction;
+
+    TraversalStack<int> stack;
+    stack.Push(root);
+
+    while (!stack.IsEmpty())
+    {
+        const Node& node = nodes[stack.Pop()];
+
+        float entry;
+        if (!RayIntersectsAABB(origin, inverseDirection, maxDistance, node.fatBounds, entry))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            if (!RayIntersectsAABB(origin, inverseDirection, maxDistance, node.tightBounds, entry))
+                continue;
+
+            float newMaxDistance = callback(node.entity, node.tightBounds, entry);
+
+            if (newMaxDistance <= 0.0f)
+                return;
+
+            if (newMaxDistance < maxDistance)
+                maxDistance = newMaxDistance;
+        }
+        else
+        {
+            stack.Push(node.child1);
+            stack.Push(node.child2);
+        }
+    }
+}
+
+template <typename Callback>
+void AabbTree::RayCastPacket(RayPacket& packet, std::uint32_t activeMask, Callback&& callback) const
+{
+    if (root == NullNode || activeMask == 0)
+        return;
+
+    struct StackEntry
+    {
+        int nodeId;
+        std::uint32_t rayMask;
+    };
+
+    TraversalStack<StackEntry> stack;
+    stack.Push({ root, activeMask });
+
+    while (!stack.IsEmpty())
+    {
+        const StackEntry entry = stack.Pop();
+        const Node& node = nodes[entry.nodeId];
+
+        // a szülő óta a callback rövidíthette a sugarakat, ezért újra tesztelünk
+        std::uint32_t rayMask = RaycastAABBPacket(packet, entry.rayMask, node.fatBounds);
+        if (rayMask == 0)
+            continue;
+
+        if (node.IsLeaf())
+        {
+            rayMask = RaycastAABBPacket(packet, rayMask, node.tightBounds);
+
+            if (rayMask != 0)
+                callback(node.entity, node.tightBounds, rayMask);
+        }
+        else
+        {
+            stack.Push({ node.child1, rayMask });
+            stack.Push({ node.child2, rayMask });
+        }
+    }
+}
+
+template <typename Callback>
+void AabbTree::QuerySwept(const AABB& shapeBounds, const glm::vec3& displacement, Callback&& callback) const
+{
+    if (root == NullNode)
+        return;
+
+    // Minkowski: a csomópontokat az alakzat fél méretével felfújjuk,
+    // és az alakzat középpontjából indított sugarat teszteljük
+    const glm::vec3 halfExtents = (shapeBounds.max - shapeBounds.min) * 0.5f;
+    const glm::vec3 origin = (shapeBounds.min + shapeBounds.max) * 0.5f;
+    const glm::vec3 inverseDirection = 1.0f / displacement;
+
+    auto Inflate = [&](const AABB& box) -> AABB
+    {
+        return { box.min - halfExtents, box.max + halfExtents };
+    };
+
+    TraversalStack<int> stack;
+    stack.Push(root);
+
+    while (!stack.IsEmpty())
+    {
+        const Node& node = nodes[stack.Pop()];
+
+        float entry;
+        if (!RayIntersectsAABB(origin, inverseDirection, 1.0f, Inflate(node.fatBounds), entry))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            if (!RayIntersectsAABB(origin, inverseDirection, 1.0f, Inflate(node.tightBounds), entry))
+                continue;
+
+            if (!callback(node.entity, node.tightBounds))
+                return;
+        }
+        else
+        {
+            stack.Push(node.child1);
+            stack.Push(node.child2);
+        }
+    }
+}
\ No newline at end of file
@@ -1,7 +1,11 @@
 #include "CameraCollision.h"
 #include "CollisionSystem.h"
+#include "CollisionStats.h"
 #include "AABB.h"
 #include "Entity.h"
+#include "CollisionWorld.h"
+#include <algorithm>
+#include <cmath>
 #include <glm/glm.hpp>
 #include <glm/geometric.hpp>
 
@@ -9,46 +13,81 @@ glm::vec3 ResolveCameraCollision(
     const glm::vec3& pivot,
     const glm::vec3& desiredPosition,
     float cameraRadius,
-    const std::vector<Entity*>& worldEntities)
+    const CollisionWorld& world)
 {
-    constexpr int Steps = 32;
+    ZS_COLLISION_TIMER(CameraCollision);
 
-    glm::vec3 direction = desiredPosition - pivot;
-    float length = glm::length(direction);
+    // ennyivel a találat előtt állunk meg, hogy a gömb ne érjen a falhoz
+    constexpr float Skin = 0.01f;
+
+    glm::vec3 displacement = desiredPosition - pivot;
+    float length = glm::length(displacement);
 
     if (length < 0.0001f)
         return desiredPosition;
 
-    direction /= length;
+    AABB sphereBounds =
+    {
+        pivot - glm::vec3(cameraRadius),
+        pivot + glm::vec3(cameraRadius)
+    };
 
-    glm::vec3 lastValid = pivot;
+    // Egyetlen söpört lekérdezés, a legkorábbi ütközési idővel
+    float earliestTime = 1.0f;
 
-    for (int i = 1; i <= Steps; ++i)
+    world.QuerySwept(sphereBounds, displacement, [&](const Entity* e, const AABB& box)
     {
-        float t = (float)i / Steps;
-        glm::vec3 testPos = pivot + direction * (length * t);
+        ZS_COLLISION_COUNT(BroadphaseCandidates);
+        ZS_COLLISION_COUNT(NarrowphaseTests);
 
-        bool collided = false;
+        float time;
+        glm::vec3 normal;
 
-        for (const Entity* e : worldEntities)
+        if (e->collision.type == CollisionShape::Type::AABB)
+        {
+            if (!SweepSphereVsAABB(pivot, displacement, cameraRadius, box, time, normal))
+                return true;
+        }
+        else if (e->collision.type == CollisionShape::Type::OBB)
         {
-            if (e->collision.type != CollisionShape::Type::AABB)
-                continue;
+            if (!SweepSphereVsOBB(pivot, displacement, cameraRadius, GetWorldOBB(*e), time, normal))
+                return true;
+        }
+        else
+        {
+            return true;
+        }
 
-            AABB box = ComputeWorldAABB(*e);
+        ZS_COLLISION_COUNT(NarrowphaseHits);
 
-            if (IntersectSphereVsAABB(testPos, cameraRadius, box))
-            {
-                collided = true;
-                break;
-            }
-        }
+        // a pivot már átfed, de kifelé mozgunk belőle: nem blokkol
+        if (time <= 0.0f && glm::dot(normal, displacement) > 0.0f)
+            return true;
+
+        earliestTime = std::min(earliestTime, time);
+        return true;
+    });
+
+    if (earliestTime >= 1.0f)
+        return desiredPosition;
 
-        if (collided)
-            return lastValid;
+    float distance = std::max(0.0f, earliestTime * length - Skin);
+
+    return pivot + displacement * (distance / length);
+}
+
+float SmoothCameraDistance(
+    float currentDistance,
+    float targetDistance,
+    float zoomOutSpeed,
+    float deltaTime)
+{
+    // Beközelítés azonnal, különben a kamera a falba lógna
+    if (targetDistance <= currentDistance)
+        return targetDistance;
 
-        lastValid = testPos;
-    }
+    // Távolodás exponenciális közelítéssel, képkocka-sebességtől függetlenül
+    float blend = 1.0f - std::exp(-zoomOutSpeed * deltaTime);
 
-    return desiredPosition;
+    return currentDistance + (targetDistance - currentDistance) * blend;
 }
\ No newline at end of file
@@ -1,12 +1,20 @@
 #pragma once
 
-#include <vector>
 #include <glm/vec3.hpp>
 
-struct Entity;
+class CollisionWorld;
 
+// A kamera gömböt analitikusan söpri végig a pivot -> desiredPosition szakaszon,
+// és a legkorábbi ütközés előtti pozíciót adja vissza.
 glm::vec3 ResolveCameraCollision(
     const glm::vec3& pivot,
     const glm::vec3& desiredPosition,
     float cameraRadius,
-    const std::vector<Entity*>& worldEntities);
\ No newline at end of file
+    const CollisionWorld& world);
+
+// Ütközéskor azonnal közelít, utána fokozatosan áll vissza a kívánt távolságra.
+float SmoothCameraDistance(
+    float currentDistance,
+    float targetDistance,
+    float zoomOutSpeed,
+    float deltaTime);
\ No newline at end of file
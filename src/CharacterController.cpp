@@ -0,0 +1,274 @@
+#include "CharacterController.h"
+#include "CollisionStats.h"
+#include "CollisionSystem.h"
+#include "CollisionWorld.h"
+#include "Entity.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/geometric.hpp>
+
+namespace
+{
+    constexpr float MinMoveDistance = 0.0001f;
+}
+
+CharacterController::CharacterController(const CharacterControllerSettings& settings)
+    : settings(settings)
+{
+}
+
+bool CharacterController::IsGrounded() const
+{
+    return grounded;
+}
+
+bool CharacterController::IsWalkable(const glm::vec3& normal) const
+{
+    return normal.y >= settings.minGroundNormalY;
+}
+
+// A kapszula alja lekerekített, így doboz élén állva a normál ferde.
+// Ilyenkor is megállhat, ha az érintkezés elég közel van a tengelyhez.
+bool CharacterController::CanStandOn(const glm::vec3& normal) const
+{
+    return normal.y >= settings.minStandNormalY;
+}
+
+void CharacterController::ComputeCapsule(const Entity& character, const glm::vec3& position, glm::vec3& outBase, glm::vec3& outTip)
+{
+    const float radius = character.collision.capsule.radius;
+    const float height = character.collision.capsule.height;
+
+    outBase = position + character.collision.localOffset + glm::vec3(0.0f, radius, 0.0f);
+    outTip = outBase + glm::vec3(0.0f, std::max(0.0f, height - 2.0f * radius), 0.0f);
+}
+
+CharacterController::SweepHit CharacterController::Sweep(
+    const Entity& character,
+    const glm::vec3& position,
+    const glm::vec3& displacement,
+    const CollisionWorld& world) const
+{
+    SweepHit result;
+
+    const float radius = character.collision.capsule.radius;
+
+    glm::vec3 base;
+    glm::vec3 tip;
+    ComputeCapsule(character, position, base, tip);
+
+    AABB capsuleBounds =
+    {
+        glm::min(base, tip) - glm::vec3(radius),
+        glm::max(base, tip) + glm::vec3(radius)
+    };
+
+    world.QuerySwept(capsuleBounds, displacement, [&](const Entity* e, const AABB& box)
+    {
+        if (e == &character)
+            return true;
+
+        ZS_COLLISION_COUNT(BroadphaseCandidates);
+
+        float time;
+        glm::vec3 normal;
+
+        ZS_COLLISION_COUNT(NarrowphaseTests);
+
+        if (e->collision.type == CollisionShape::Type::AABB)
+        {
+            if (!SweepCapsuleVsAABB(base, tip, radius, displacement, box, time, normal))
+                return true;
+        }
+        else if (e->collision.type == CollisionShape::Type::OBB)
+        {
+            if (!SweepCapsuleVsOBB(base, tip, radius, displacement, GetWorldOBB(*e), time, normal))
+                return true;
+        }
+        else
+        {
+            return true;
+        }
+
+        ZS_COLLISION_COUNT(NarrowphaseHits);
+
+        // érintkezésből kifelé vagy érintőlegesen mozgunk: nem blokkol
+        if (glm::dot(normal, displacement) >= 0.0f)
+            return true;
+
+        if (time < result.time || !result.hit)
+        {
+            result.hit = true;
+            result.time = time;
+            result.normal = normal;
+        }
+
+        return true;
+    });
+
+    return result;
+}
+
+glm::vec3 CharacterController::SlideMove(
+    const Entity& character,
+    glm::vec3 position,
+    const glm::vec3& displacement,
+    const CollisionWorld& world,
+    bool horizontalOnly,
+    bool& outHitGround) const
+{
+    glm::vec3 remaining = displacement;
+    glm::vec3 firstNormal(0.0f);
+
+    outHitGround = false;
+
+    for (int iteration = 0; iteration < settings.maxSlideIterations; ++iteration)
+    {
+        const float length = glm::length(remaining);
+        if (length < MinMoveDistance)
+            break;
+
+        SweepHit hit = Sweep(character, position, remaining, world);
+
+        if (!hit.hit)
+        {
+            position += remaining;
+            break;
+        }
+
+        // a találat előtt skinWidth-nyivel megállunk
+        const glm::vec3 direction = remaining / length;
+        const float travel = std::max(0.0f, hit.time * length - settings.skinWidth);
+        position += direction * travel;
+
+        if (IsWalkable(hit.normal))
+            outHitGround = true;
+
+        // Vízszintes mozgásnál a nem járható felület (fal, doboz éle) függőleges
+        // falnak számít, így a kapszula alja nem kúszik fel az éleken
+        glm::vec3 slideNormal = hit.normal;
+
+        if (horizontalOnly && !IsWalkable(hit.normal))
+        {
+            slideNormal.y = 0.0f;
+            float slideNormalLength = glm::length(slideNormal);
+
+            if (slideNormalLength < MinMoveDistance)
+                break;
+
+            slideNormal /= slideNormalLength;
+        }
+
+        // a maradékot a felület síkjára vetítjük
+        glm::vec3 leftover = remaining - direction * travel;
+        remaining = leftover - slideNormal * glm::dot(leftover, slideNormal);
+
+        // két felület között (sarok, ék) a metszésvonal mentén csúszunk tovább
+        if (iteration == 0)
+        {
+            firstNormal = slideNormal;
+        }
+        else if (glm::dot(remaining, firstNormal) < 0.0f)
+        {
+            glm::vec3 crease = glm::cross(firstNormal, slideNormal);
+            float creaseLength = glm::length(crease);
+
+            if (creaseLength < MinMoveDistance)
+                break;
+
+            crease /= creaseLength;
+            remaining = crease * glm::dot(remaining, crease);
+        }
+    }
+
+    return position;
+}
+
+void CharacterController::Move(Entity& character, const glm::vec3& desiredDisplacement, float deltaTime, const CollisionWorld& world)
+{
+    glm::vec3 position = character.transform.position;
+
+    // ---- Horizontal ----
+    glm::vec3 horizontal(desiredDisplacement.x, 0.0f, desiredDisplacement.z);
+
+    if (glm::length(horizontal) > MinMoveDistance)
+    {
+        bool hitGround;
+        glm::vec3 slid = SlideMove(character, position, horizontal, world, true, hitGround);
+
+        // Akadály esetén fellépést próbálunk: fel, előre, vissza le
+        const float requested = glm::length(horizontal);
+        const float achieved = glm::length(glm::vec3(slid.x - position.x, 0.0f, slid.z - position.z));
+
+        if (grounded && achieved < requested - MinMoveDistance)
+        {
+            glm::vec3 up(0.0f, settings.stepHeight, 0.0f);
+
+            SweepHit ceiling = Sweep(character, position, up, world);
+            float upTravel = ceiling.hit
+                ? std::max(0.0f, ceiling.time * settings.stepHeight - settings.skinWidth)
+                : settings.stepHeight;
+
+            glm::vec3 stepped = position + glm::vec3(0.0f, upTravel, 0.0f);
+            stepped = SlideMove(character, stepped, horizontal, world, true, hitGround);
+
+            glm::vec3 down(0.0f, -(upTravel + settings.groundSnapDistance), 0.0f);
+            SweepHit floor = Sweep(character, stepped, down, world);
+
+            const float steppedAchieved = glm::length(glm::vec3(stepped.x - position.x, 0.0f, stepped.z - position.z));
+
+            if (floor.hit && CanStandOn(floor.normal) && steppedAchieved > achieved + MinMoveDistance)
+            {
+                float downTravel = std::max(0.0f, floor.time * -down.y - settings.skinWidth);
+                slid = stepped + glm::vec3(0.0f, -downTravel, 0.0f);
+            }
+        }
+
+        position = slid;
+    }
+
+    // ---- Vertical ----
+    if (grounded)
+    {
+        verticalVelocity = 0.0f;
+    }
+    else
+    {
+        verticalVelocity = std::max(verticalVelocity - settings.gravity * deltaTime, -settings.maxFallSpeed);
+    }
+
+    bool landed = false;
+    float vertical = verticalVelocity * deltaTime + desiredDisplacement.y;
+
+    if (std::abs(vertical) > MinMoveDistance)
+    {
+        const float startY = position.y;
+        position = SlideMove(character, position, glm::vec3(0.0f, vertical, 0.0f), world, false, landed);
+
+        // felfelé mozgás közben plafonba ütköztünk
+        if (verticalVelocity > 0.0f && position.y - startY < vertical - MinMoveDistance)
+            verticalVelocity = 0.0f;
+    }
+
+    // ---- Ground snap ----
+    grounded = landed;
+
+    if (verticalVelocity <= 0.0f)
+    {
+        glm::vec3 snap(0.0f, -(settings.groundSnapDistance + settings.skinWidth), 0.0f);
+        SweepHit floor = Sweep(character, position, snap, world);
+
+        if (floor.hit && CanStandOn(floor.normal))
+        {
+            float snapTravel = std::max(0.0f, floor.time * -snap.y - settings.skinWidth);
+            position.y -= snapTravel;
+            grounded = true;
+        }
+    }
+
+    if (grounded)
+        verticalVelocity = 0.0f;
+
+    character.transform.position = position;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+
+struct Entity;
+class CollisionWorld;
+
+struct CharacterControllerSettings
+{
+    float stepHeight = 0.35f;         // ekkora lépcsőre fel tud lépni
+    float groundSnapDistance = 0.2f;  // lefelé ennyin belül a talajhoz tapad
+    float skinWidth = 0.01f;          // ennyire áll meg a felületek előtt
+    float minGroundNormalY = 0.7f;    // ennél meredekebb felület fal (kb. 45 fok)
+    float minStandNormalY = 0.3f;     // élen állva ennél laposabb érintkezés kell
+    float gravity = 20.0f;
+    float maxFallSpeed = 30.0f;
+    int maxSlideIterations = 4;       // a költség így felülről korlátos
+};
+
+// Söpört kapszulás karaktermozgatás: collide-and-slide, fellépés és talajra tapadás.
+class CharacterController
+{
+public:
+    explicit CharacterController(const CharacterControllerSettings& settings = {});
+
+    // desiredDisplacement: a bemenetből számolt elmozdulás erre a képkockára,
+    // a gravitációt a controller adja hozzá
+    void Move(Entity& character, const glm::vec3& desiredDisplacement, float deltaTime, const CollisionWorld& world);
+
+    bool IsGrounded() const;
+
+    static void ComputeCapsule(const Entity& character, const glm::vec3& position, glm::vec3& outBase, glm::vec3& outTip);
+
+private:
+    struct SweepHit
+    {
+        bool hit = false;
+        float time = 1.0f;
+        glm::vec3 normal = glm::vec3(0.0f);
+    };
+
+    SweepHit Sweep(const Entity& character, const glm::vec3& position, const glm::vec3& displacement, const CollisionWorld& world) const;
+
+    // bounded collide-and-slide, visszaadja a végső pozíciót
+    glm::vec3 SlideMove(
+        const Entity& character,
+        glm::vec3 position,
+        const glm::vec3& displacement,
+        const CollisionWorld& world,
+        bool horizontalOnly,
+        bool& outHitGround) const;
+
+    bool IsWalkable(const glm::vec3& normal) const;
+    bool CanStandOn(const glm::vec3& normal) const;
+
+private:
+    CharacterControllerSettings settings;
+
+    float verticalVelocity = 0.0f;
+    bool grounded = false;
+};
\ No newline at end of file
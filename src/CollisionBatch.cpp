@@ -0,0 +1,572 @@
+#include "CollisionBatch.h"
+#include "CollisionSystem.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glm/geometric.hpp>
+
+void AABBSoA::Clear()
+{
+    minX.clear();
+    minY.clear();
+    minZ.clear();
+    maxX.clear();
+    maxY.clear();
+    maxZ.clear();
+}
+
+void AABBSoA::Reserve(std::size_t count)
+{
+    minX.reserve(count);
+    minY.reserve(count);
+    minZ.reserve(count);
+    maxX.reserve(count);
+    maxY.reserve(count);
+    maxZ.reserve(count);
+}
+
+void AABBSoA::Resize(std::size_t count)
+{
+    minX.resize(count);
+    minY.resize(count);
+    minZ.resize(count);
+    maxX.resize(count);
+    maxY.resize(count);
+    maxZ.resize(count);
+}
+
+void AABBSoA::Add(const AABB& box)
+{
+    minX.push_back(box.min.x);
+    minY.push_back(box.min.y);
+    minZ.push_back(box.min.z);
+    maxX.push_back(box.max.x);
+    maxY.push_back(box.max.y);
+    maxZ.push_back(box.max.z);
+}
+
+void AABBSoA::PopBack()
+{
+    minX.pop_back();
+    minY.pop_back();
+    minZ.pop_back();
+    maxX.pop_back();
+    maxY.pop_back();
+    maxZ.pop_back();
+}
+
+void AABBSoA::Set(std::size_t index, const AABB& box)
+{
+    minX[index] = box.min.x;
+    minY[index] = box.min.y;
+    minZ[index] = box.min.z;
+    maxX[index] = box.max.x;
+    maxY[index] = box.max.y;
+    maxZ[index] = box.max.z;
+}
+
+AABB AABBSoA::Get(std::size_t index) const
+{
+    return
+    {
+        glm::vec3(minX[index], minY[index], minZ[index]),
+        glm::vec3(maxX[index], maxY[index], maxZ[index])
+    };
+}
+
+std::size_t AABBSoA::Size() const
+{
+    return minX.size();
+}
+
+void RayPacket::Set(std::size_t lane, const glm::vec3& origin, const glm::vec3& direction, float distance)
+{
+    // A 0 komponens végtelen inverzet adna, ami a slab síkján 0 * inf = NaN.
+    // Egy nagyon kicsi komponens helyette ugyanazt az eredményt adja NaN nélkül.
+    auto Inverse = [](float component)
+    {
+        constexpr float MinComponent = 1e-8f;
+
+        if (std::abs(component) < MinComponent)
+            component = component < 0.0f ? -MinComponent : MinComponent;
+
+        return 1.0f / component;
+    };
+
+    originX[lane] = origin.x;
+    originY[lane] = origin.y;
+    originZ[lane] = origin.z;
+    inverseDirectionX[lane] = Inverse(direction.x);
+    inverseDirectionY[lane] = Inverse(direction.y);
+    inverseDirectionZ[lane] = Inverse(direction.z);
+    maxDistance[lane] = distance;
+}
+
+void RayPacket::Clear()
+{
+    for (std::size_t lane = 0; lane < RayPacketSize; ++lane)
+    {
+        originX[lane] = 0.0f;
+        originY[lane] = 0.0f;
+        originZ[lane] = 0.0f;
+        inverseDirectionX[lane] = 1.0f;
+        inverseDirectionY[lane] = 1.0f;
+        inverseDirectionZ[lane] = 1.0f;
+        maxDistance[lane] = -1.0f;
+    }
+}
+
+namespace
+{
+    using SphereBatchFunction = std::uint32_t(*)(const glm::vec3&, float, const AABBSoA&, std::size_t, std::size_t);
+    using CapsuleBatchFunction = std::uint32_t(*)(const glm::vec3&, const glm::vec3&, float, const AABBSoA&, std::size_t, std::size_t);
+    using RayPacketFunction = std::uint32_t(*)(const RayPacket&, std::uint32_t, const AABB&);
+
+    // A SIMD ágak a maradékot (count % szélesség) is ezekkel számolják
+    std::uint32_t SphereBatchScalar(
+        const glm::vec3& center, float radius, const AABBSoA& boxes, std::size_t first, std::size_t count)
+    {
+        std::uint32_t mask = 0;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (IntersectSphereVsAABB(center, radius, boxes.Get(first + i)))
+                mask |= 1u << i;
+        }
+
+        return mask;
+    }
+
+    std::uint32_t CapsuleBatchScalar(
+        const glm::vec3& base, const glm::vec3& tip, float radius, const AABBSoA& boxes, std::size_t first, std::size_t count)
+    {
+        std::uint32_t mask = 0;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (IntersectCapsuleVsAABB(base, tip, radius, boxes.Get(first + i)))
+                mask |= 1u << i;
+        }
+
+        return mask;
+    }
+
+    std::uint32_t RayPacketScalar(const RayPacket& packet, std::uint32_t activeMask, const AABB& box)
+    {
+        std::uint32_t mask = 0;
+
+        for (std::size_t lane = 0; lane < RayPacketSize; ++lane)
+        {
+            if ((activeMask & (1u << lane)) == 0)
+                continue;
+
+            const float t1x = (box.min.x - packet.originX[lane]) * packet.inverseDirectionX[lane];
+            const float t2x = (box.max.x - packet.originX[lane]) * packet.inverseDirectionX[lane];
+            const float t1y = (box.min.y - packet.originY[lane]) * packet.inverseDirectionY[lane];
+            const float t2y = (box.max.y - packet.originY[lane]) * packet.inverseDirectionY[lane];
+            const float t1z = (box.min.z - packet.originZ[lane]) * packet.inverseDirectionZ[lane];
+            const float t2z = (box.max.z - packet.originZ[lane]) * packet.inverseDirectionZ[lane];
+
+            const float tNear = std::max({ std::min(t1x, t2x), std::min(t1y, t2y), std::min(t1z, t2z), 0.0f });
+            const float tFar = std::min({ std::max(t1x, t2x), std::max(t1y, t2y), std::max(t1z, t2z), packet.maxDistance[lane] });
+
+            if (tNear <= tFar)
+                mask |= 1u << lane;
+        }
+
+        return mask;
+    }
+
+#ifdef ZS_SIMD_X86
+
+    ZS_TARGET_SSE2 std::uint32_t SphereBatchSSE(
+        const glm::vec3& center, float radius, const AABBSoA& boxes, std::size_t first, std::size_t count)
+    {
+        const __m128 cx = _mm_set1_ps(center.x);
+        const __m128 cy = _mm_set1_ps(center.y);
+        const __m128 cz = _mm_set1_ps(center.z);
+        const __m128 r2 = _mm_set1_ps(radius * radius);
+
+        std::uint32_t mask = 0;
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const std::size_t index = first + i;
+
+            // legközelebbi pont a dobozon: clamp(center, min, max)
+            __m128 px = _mm_min_ps(_mm_max_ps(cx, _mm_loadu_ps(&boxes.minX[index])), _mm_loadu_ps(&boxes.maxX[index]));
+            __m128 py = _mm_min_ps(_mm_max_ps(cy, _mm_loadu_ps(&boxes.minY[index])), _mm_loadu_ps(&boxes.maxY[index]));
+            __m128 pz = _mm_min_ps(_mm_max_ps(cz, _mm_loadu_ps(&boxes.minZ[index])), _mm_loadu_ps(&boxes.maxZ[index]));
+
+            __m128 dx = _mm_sub_ps(cx, px);
+            __m128 dy = _mm_sub_ps(cy, py);
+            __m128 dz = _mm_sub_ps(cz, pz);
+
+            __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+            mask |= static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmple_ps(d2, r2))) << i;
+        }
+
+        if (i < count)
+            mask |= SphereBatchScalar(center, radius, boxes, first + i, count - i) << i;
+
+        return mask;
+    }
+
+    ZS_TARGET_SSE2 std::uint32_t CapsuleBatchSSE(
+        const glm::vec3& base, const glm::vec3& tip, float radius, const AABBSoA& boxes, std::size_t first, std::size_t count)
+    {
+        glm::vec3 ab = tip - base;
+        float abLength2 = glm::dot(ab, ab);
+
+        // elfajult kapszula: a skalár út is t = 0-t ad (NaN clamp)
+        if (abLength2 <= 0.0f)
+        {
+            ab = glm::vec3(0.0f);
+            abLength2 = 1.0f;
+        }
+
+        const __m128 bx = _mm_set1_ps(base.x);
+        const __m128 by = _mm_set1_ps(base.y);
+        const __m128 bz = _mm_set1_ps(base.z);
+        const __m128 abx = _mm_set1_ps(ab.x);
+        const __m128 aby = _mm_set1_ps(ab.y);
+        const __m128 abz = _mm_set1_ps(ab.z);
+        const __m128 len2 = _mm_set1_ps(abLength2);
+        const __m128 r2 = _mm_set1_ps(radius * radius);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        std::uint32_t mask = 0;
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const std::size_t index = first + i;
+
+            const __m128 mnx = _mm_loadu_ps(&boxes.minX[index]);
+            const __m128 mny = _mm_loadu_ps(&boxes.minY[index]);
+            const __m128 mnz = _mm_loadu_ps(&boxes.minZ[index]);
+            const __m128 mxx = _mm_loadu_ps(&boxes.maxX[index]);
+            const __m128 mxy = _mm_loadu_ps(&boxes.maxY[index]);
+            const __m128 mxz = _mm_loadu_ps(&boxes.maxZ[index]);
+
+            // doboz középpontjához legközelebbi pont a tengelyen
+            __m128 wx = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(mnx, mxx), half), bx);
+            __m128 wy = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(mny, mxy), half), by);
+            __m128 wz = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(mnz, mxz), half), bz);
+
+            __m128 t = _mm_add_ps(_mm_add_ps(_mm_mul_ps(wx, abx), _mm_mul_ps(wy, aby)), _mm_mul_ps(wz, abz));
+            t = _mm_min_ps(_mm_max_ps(_mm_div_ps(t, len2), zero), one);
+
+            __m128 cx = _mm_add_ps(bx, _mm_mul_ps(abx, t));
+            __m128 cy = _mm_add_ps(by, _mm_mul_ps(aby, t));
+            __m128 cz = _mm_add_ps(bz, _mm_mul_ps(abz, t));
+
+            __m128 dx = _mm_sub_ps(cx, _mm_min_ps(_mm_max_ps(cx, mnx), mxx));
+            __m128 dy = _mm_sub_ps(cy, _mm_min_ps(_mm_max_ps(cy, mny), mxy));
+            __m128 dz = _mm_sub_ps(cz, _mm_min_ps(_mm_max_ps(cz, mnz), mxz));
+
+            __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+            mask |= static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmple_ps(d2, r2))) << i;
+        }
+
+        if (i < count)
+            mask |= CapsuleBatchScalar(base, tip, radius, boxes, first + i, count - i) << i;
+
+        return mask;
+    }
+
+    ZS_TARGET_AVX2 std::uint32_t SphereBatchAVX2(
+        const glm::vec3& center, float radius, const AABBSoA& boxes, std::size_t first, std::size_t count)
+    {
+        const __m256 cx = _mm256_set1_ps(center.x);
+        const __m256 cy = _mm256_set1_ps(center.y);
+        const __m256 cz = _mm256_set1_ps(center.z);
+        const __m256 r2 = _mm256_set1_ps(radius * radius);
+
+        std::uint32_t mask = 0;
+        std::size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            const std::size_t index = first + i;
+
+            __m256 px = _mm256_min_ps(_mm256_max_ps(cx, _mm256_loadu_ps(&boxes.minX[index])), _mm256_loadu_ps(&boxes.maxX[index]));
+            __m256 py = _mm256_min_ps(_mm256_max_ps(cy, _mm256_loadu_ps(&boxes.minY[index])), _mm256_loadu_ps(&boxes.maxY[index]));
+            __m256 pz = _mm256_min_ps(_mm256_max_ps(cz, _mm256_loadu_ps(&boxes.minZ[index])), _mm256_loadu_ps(&boxes.maxZ[index]));
+
+            __m256 dx = _mm256_sub_ps(cx, px);
+            __m256 dy = _mm256_sub_ps(cy, py);
+            __m256 dz = _mm256_sub_ps(cz, pz);
+
+            __m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+
+            mask |= static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(d2, r2, _CMP_LE_OQ))) << i;
+        }
+
+        if (i < count)
+            mask |= SphereBatchSSE(center, radius, boxes, first + i, count - i) << i;
+
+        return mask;
+    }
+
+    ZS_TARGET_AVX2 std::uint32_t CapsuleBatchAVX2(
+        const glm::vec3& base, const glm::vec3& tip, float radius, const AABBSoA& boxes, std::size_t first, std::size_t count)
+    {
+        glm::vec3 ab = tip - base;
+        float abLength2 = glm::dot(ab, ab);
+
+        if (abLength2 <= 0.0f)
+        {
+            ab = glm::vec3(0.0f);
+            abLength2 = 1.0f;
+        }
+
+        const __m256 bx = _mm256_set1_ps(base.x);
+        const __m256 by = _mm256_set1_ps(base.y);
+        const __m256 bz = _mm256_set1_ps(base.z);
+        const __m256 abx = _mm256_set1_ps(ab.x);
+        const __m256 aby = _mm256_set1_ps(ab.y);
+        const __m256 abz = _mm256_set1_ps(ab.z);
+        const __m256 len2 = _mm256_set1_ps(abLength2);
+        const __m256 r2 = _mm256_set1_ps(radius * radius);
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+
+        std::uint32_t mask = 0;
+        std::size_t i = 0;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            const std::size_t index = first + i;
+
+            const __m256 mnx = _mm256_loadu_ps(&boxes.minX[index]);
+            const __m256 mny = _mm256_loadu_ps(&boxes.minY[index]);
+            const __m256 mnz = _mm256_loadu_ps(&boxes.minZ[index]);
+            const __m256 mxx = _mm256_loadu_ps(&boxes.maxX[index]);
+            const __m256 mxy = _mm256_loadu_ps(&boxes.maxY[index]);
+            const __m256 mxz = _mm256_loadu_ps(&boxes.maxZ[index]);
+
+            __m256 wx = _mm256_sub_ps(_mm256_mul_ps(_mm256_add_ps(mnx, mxx), half), bx);
+            __m256 wy = _mm256_sub_ps(_mm256_mul_ps(_mm256_add_ps(mny, mxy), half), by);
+            __m256 wz = _mm256_sub_ps(_mm256_mul_ps(_mm256_add_ps(mnz, mxz), half), bz);
+
+            __m256 t = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(wx, abx), _mm256_mul_ps(wy, aby)), _mm256_mul_ps(wz, abz));
+            t = _mm256_min_ps(_mm256_max_ps(_mm256_div_ps(t, len2), zero), one);
+
+            __m256 cx = _mm256_add_ps(bx, _mm256_mul_ps(abx, t));
+            __m256 cy = _mm256_add_ps(by, _mm256_mul_ps(aby, t));
+            __m256 cz = _mm256_add_ps(bz, _mm256_mul_ps(abz, t));
+
+            __m256 dx = _mm256_sub_ps(cx, _mm256_min_ps(_mm256_max_ps(cx, mnx), mxx));
+            __m256 dy = _mm256_sub_ps(cy, _mm256_min_ps(_mm256_max_ps(cy, mny), mxy));
+            __m256 dz = _mm256_sub_ps(cz, _mm256_min_ps(_mm256_max_ps(cz, mnz), mxz));
+
+            __m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+
+            mask |= static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(d2, r2, _CMP_LE_OQ))) << i;
+        }
+
+        if (i < count)
+            mask |= CapsuleBatchSSE(base, tip, radius, boxes, first + i, count - i) << i;
+
+        return mask;
+    }
+
+    ZS_TARGET_SSE2 std::uint32_t RayPacketSSE(const RayPacket& packet, std::uint32_t activeMask, const AABB& box)
+    {
+        const __m128 mnx = _mm_set1_ps(box.min.x);
+        const __m128 mny = _mm_set1_ps(box.min.y);
+        const __m128 mnz = _mm_set1_ps(box.min.z);
+        const __m128 mxx = _mm_set1_ps(box.max.x);
+        const __m128 mxy = _mm_set1_ps(box.max.y);
+        const __m128 mxz = _mm_set1_ps(box.max.z);
+        const __m128 zero = _mm_setzero_ps();
+
+        std::uint32_t mask = 0;
+
+        for (std::size_t lane = 0; lane < RayPacketSize; lane += 4)
+        {
+            if (((activeMask >> lane) & 0xFu) == 0)
+                continue;
+
+            const __m128 ox = _mm_load_ps(&packet.originX[lane]);
+            const __m128 oy = _mm_load_ps(&packet.originY[lane]);
+            const __m128 oz = _mm_load_ps(&packet.originZ[lane]);
+            const __m128 ix = _mm_load_ps(&packet.inverseDirectionX[lane]);
+            const __m128 iy = _mm_load_ps(&packet.inverseDirectionY[lane]);
+            const __m128 iz = _mm_load_ps(&packet.inverseDirectionZ[lane]);
+
+            const __m128 t1x = _mm_mul_ps(_mm_sub_ps(mnx, ox), ix);
+            const __m128 t2x = _mm_mul_ps(_mm_sub_ps(mxx, ox), ix);
+            const __m128 t1y = _mm_mul_ps(_mm_sub_ps(mny, oy), iy);
+            const __m128 t2y = _mm_mul_ps(_mm_sub_ps(mxy, oy), iy);
+            const __m128 t1z = _mm_mul_ps(_mm_sub_ps(mnz, oz), iz);
+            const __m128 t2z = _mm_mul_ps(_mm_sub_ps(mxz, oz), iz);
+
+            __m128 tNear = _mm_max_ps(_mm_min_ps(t1x, t2x), _mm_min_ps(t1y, t2y));
+            tNear = _mm_max_ps(tNear, _mm_max_ps(_mm_min_ps(t1z, t2z), zero));
+
+            __m128 tFar = _mm_min_ps(_mm_max_ps(t1x, t2x), _mm_max_ps(t1y, t2y));
+            tFar = _mm_min_ps(tFar, _mm_min_ps(_mm_max_ps(t1z, t2z), _mm_load_ps(&packet.maxDistance[lane])));
+
+            mask |= static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmple_ps(tNear, tFar))) << lane;
+        }
+
+        return mask & activeMask;
+    }
+
+    ZS_TARGET_AVX2 std::uint32_t RayPacketAVX2(const RayPacket& packet, std::uint32_t activeMask, const AABB& box)
+    {
+        const __m256 ox = _mm256_load_ps(packet.originX);
+        const __m256 oy = _mm256_load_ps(packet.originY);
+        const __m256 oz = _mm256_load_ps(packet.originZ);
+        const __m256 ix = _mm256_load_ps(packet.inverseDirectionX);
+        const __m256 iy = _mm256_load_ps(packet.inverseDirectionY);
+        const __m256 iz = _mm256_load_ps(packet.inverseDirectionZ);
+
+        const __m256 t1x = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.min.x), ox), ix);
+        const __m256 t2x = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.max.x), ox), ix);
+        const __m256 t1y = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.min.y), oy), iy);
+        const __m256 t2y = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.max.y), oy), iy);
+        const __m256 t1z = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.min.z), oz), iz);
+        const __m256 t2z = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.max.z), oz), iz);
+
+        __m256 tNear = _mm256_max_ps(_mm256_min_ps(t1x, t2x), _mm256_min_ps(t1y, t2y));
+        tNear = _mm256_max_ps(tNear, _mm256_max_ps(_mm256_min_ps(t1z, t2z), _mm256_setzero_ps()));
+
+        __m256 tFar = _mm256_min_ps(_mm256_max_ps(t1x, t2x), _mm256_max_ps(t1y, t2y));
+        tFar = _mm256_min_ps(tFar, _mm256_min_ps(_mm256_max_ps(t1z, t2z), _mm256_load_ps(packet.maxDistance)));
+
+        const std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ)));
+
+        return mask & activeMask;
+    }
+
+#endif
+
+    struct BatchKernels
+    {
+        SimdLevel level;
+        SphereBatchFunction sphere;
+        CapsuleBatchFunction capsule;
+        RayPacketFunction rayPacket;
+    };
+
+    BatchKernels MakeKernels(SimdLevel level)
+    {
+        switch (level)
+        {
+#ifdef ZS_SIMD_X86
+        case SimdLevel::AVX2:
+            return { SimdLevel::AVX2, SphereBatchAVX2, CapsuleBatchAVX2, RayPacketAVX2 };
+        case SimdLevel::SSE:
+            return { SimdLevel::SSE, SphereBatchSSE, CapsuleBatchSSE, RayPacketSSE };
+#endif
+        default:
+            return { SimdLevel::Scalar, SphereBatchScalar, CapsuleBatchScalar, RayPacketScalar };
+        }
+    }
+
+    BatchKernels kernels = MakeKernels(DetectSimdLevel());
+}
+
+SimdLevel DetectSimdLevel()
+{
+#if defined(ZS_SIMD_X86) && defined(_MSC_VER)
+    int info[4];
+
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    const bool sse2 = (info[3] & (1 << 26)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+
+    bool avx2 = false;
+    if (maxLeaf >= 7)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+
+    // az OS-nek is mentenie kell az YMM regisztereket
+    if (osxsave && avx && avx2 && (_xgetbv(0) & 0x6) == 0x6)
+        return SimdLevel::AVX2;
+
+    return sse2 ? SimdLevel::SSE : SimdLevel::Scalar;
+#elif defined(ZS_SIMD_X86)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+        return SimdLevel::AVX2;
+
+    return __builtin_cpu_supports("sse2") ? SimdLevel::SSE : SimdLevel::Scalar;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel GetSimdLevel()
+{
+    return kernels.level;
+}
+
+void SetSimdLevel(SimdLevel level)
+{
+    SimdLevel supported = DetectSimdLevel();
+
+    if (static_cast<int>(level) > static_cast<int>(supported))
+        level = supported;
+
+    kernels = MakeKernels(level);
+}
+
+const char* GetSimdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::AVX2:
+        return "AVX2";
+    case SimdLevel::SSE:
+        return "SSE";
+    default:
+        return "Scalar";
+    }
+}
+
+std::uint32_t IntersectSphereVsAABBBatch(
+    const glm::vec3& sphereCenter,
+    float sphereRadius,
+    const AABBSoA& boxes,
+    std::size_t first,
+    std::size_t count)
+{
+    return kernels.sphere(sphereCenter, sphereRadius, boxes, first, count);
+}
+
+std::uint32_t IntersectCapsuleVsAABBBatch(
+    const glm::vec3& capsuleBase,
+    const glm::vec3& capsuleTip,
+    float capsuleRadius,
+    const AABBSoA& boxes,
+    std::size_t first,
+    std::size_t count)
+{
+    return kernels.capsule(capsuleBase, capsuleTip, capsuleRadius, boxes, first, count);
+}
+
+std::uint32_t RaycastAABBPacket(
+    const RayPacket& packet,
+    std::uint32_t activeMask,
+    const AABB& box)
+{
+    return kernels.rayPacket(packet, activeMask, box);
+}
\ No newline at end of file
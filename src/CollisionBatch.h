@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/vec3.hpp>
+#include "AABB.h"
+
+// AABB-k structure-of-arrays elrendezésben, a SIMD kernelek bemenete.
+struct AABBSoA
+{
+    std::vector<float> minX;
+    std::vector<float> minY;
+    std::vector<float> minZ;
+    std::vector<float> maxX;
+    std::vector<float> maxY;
+    std::vector<float> maxZ;
+
+    void Clear();
+    void Reserve(std::size_t count);
+    void Resize(std::size_t count); // az új elemek a Set-tel tölthetők (akár párhuzamosan)
+    void Add(const AABB& box);
+    void PopBack();
+    void Set(std::size_t index, const AABB& box);
+    AABB Get(std::size_t index) const;
+    std::size_t Size() const;
+};
+
+enum class SimdLevel
+{
+    Scalar,
+    SSE,  // 4 doboz egyszerre
+    AVX2  // 8 doboz egyszerre
+};
+
+// Egy hívás legfeljebb ennyi dobozt tesztel, a találatok bitmaszkban jönnek vissza
+constexpr std::size_t CollisionBatchSize = 32;
+
+// Ennyi sugarat tesztelünk együtt egy dobozzal (egy AVX2 regiszter)
+constexpr std::size_t RayPacketSize = 8;
+
+// Sugárcsomag SoA elrendezésben. A maxDistance-t a bejárás közben a
+// találatok csökkentik, így a csomag a közelebbi találat mögé nem néz.
+struct RayPacket
+{
+    alignas(32) float originX[RayPacketSize];
+    alignas(32) float originY[RayPacketSize];
+    alignas(32) float originZ[RayPacketSize];
+    alignas(32) float inverseDirectionX[RayPacketSize];
+    alignas(32) float inverseDirectionY[RayPacketSize];
+    alignas(32) float inverseDirectionZ[RayPacketSize];
+    alignas(32) float maxDistance[RayPacketSize];
+
+    // A nem használt sávok maxDistance-e negatív, ezek sosem találnak
+    void Set(std::size_t lane, const glm::vec3& origin, const glm::vec3& direction, float distance);
+    void Clear();
+};
+
+SimdLevel DetectSimdLevel();
+
+// Induláskor a DetectSimdLevel eredménye, benchmarkhoz felülírható
+// (a CPU által nem támogatott szintet a legjobb elérhetőre korlátozza)
+SimdLevel GetSimdLevel();
+void SetSimdLevel(SimdLevel level);
+
+const char* GetSimdLevelName(SimdLevel level);
+
+// A boxes [first, first + count) tartományát teszteli, count <= CollisionBatchSize.
+// A visszaadott maszk i. bitje a first + i. doboz találata.
+std::uint32_t IntersectSphereVsAABBBatch(
+    const glm::vec3& sphereCenter,
+    float sphereRadius,
+    const AABBSoA& boxes,
+    std::size_t first,
+    std::size_t count);
+
+std::uint32_t IntersectCapsuleVsAABBBatch(
+    const glm::vec3& capsuleBase,
+    const glm::vec3& capsuleTip,
+    float capsuleRadius,
+    const AABBSoA& boxes,
+    std::size_t first,
+    std::size_t count);
+
+// Slab teszt: a packet activeMask-ban jelölt sugarai közül melyek metszik a
+// dobozt a [0, maxDistance] szakaszon. A visszaadott maszk az activeMask része.
+std::uint32_t RaycastAABBPacket(
+    const RayPacket& packet,
+    std::uint32_t activeMask,
+    const AABB& box);
\ No newline at end of file
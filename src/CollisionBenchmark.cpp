@@ -0,0 +1,255 @@
+#include "CollisionBenchmark.h"
+
+#ifdef ENGINE_BENCHMARKS
+
+#include "CollisionBatch.h"
+#include "CollisionWorld.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <glm/geometric.hpp>
+
+namespace
+{
+    constexpr std::size_t BenchmarkBoxCount = 4096;
+    constexpr int BenchmarkQueryCount = 2000;
+
+    constexpr std::size_t RaycastZombieCount = 256;
+    constexpr std::size_t RaycastRayCount = 4096;
+
+    // sűrű barikád klaszter: sok kis doboz kis területen
+    AABBSoA MakeBarricadeCluster(std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> extent(0.1f, 1.0f);
+
+        AABBSoA boxes;
+        boxes.Reserve(BenchmarkBoxCount);
+
+        for (std::size_t i = 0; i < BenchmarkBoxCount; ++i)
+        {
+            glm::vec3 center(position(random), position(random) * 0.1f + 1.0f, position(random));
+            glm::vec3 halfExtents(extent(random), extent(random), extent(random));
+
+            boxes.Add({ center - halfExtents, center + halfExtents });
+        }
+
+        return boxes;
+    }
+
+    struct BenchmarkResult
+    {
+        double seconds = 0.0;
+        std::uint64_t hits = 0;
+        std::uint64_t checksum = 0;
+    };
+
+    template <typename Kernel>
+    BenchmarkResult Measure(const AABBSoA& boxes, const std::vector<glm::vec3>& queries, Kernel&& kernel)
+    {
+        BenchmarkResult result;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (const glm::vec3& query : queries)
+        {
+            for (std::size_t first = 0; first < boxes.Size(); first += CollisionBatchSize)
+            {
+                std::size_t count = std::min(CollisionBatchSize, boxes.Size() - first);
+                std::uint32_t mask = kernel(query, boxes, first, count);
+
+                result.hits += static_cast<std::uint64_t>(std::popcount(mask));
+                result.checksum = result.checksum * 31 + mask;
+            }
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        result.seconds = std::chrono::duration<double>(end - start).count();
+
+        return result;
+    }
+
+    void Report(const char* name, SimdLevel level, const BenchmarkResult& result, const BenchmarkResult& reference)
+    {
+        const double boxesTested = static_cast<double>(BenchmarkBoxCount) * BenchmarkQueryCount;
+        const double throughput = boxesTested / result.seconds / 1.0e6;
+        const double speedup = reference.seconds / result.seconds;
+
+        std::cout
+            << "  " << name << " [" << GetSimdLevelName(level) << "]: "
+            << throughput << " Mbox/s, x" << speedup
+            << (result.checksum == reference.checksum ? "" : "  MISMATCH")
+            << "\n";
+    }
+
+    double MeasureRaycast(const CollisionWorld& world, const std::vector<Ray>& rays, std::vector<RaycastHit>& hits)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        world.RaycastBatch(rays.data(), rays.size(), hits.data());
+
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    }
+
+    bool SameHits(const std::vector<RaycastHit>& a, const std::vector<RaycastHit>& b)
+    {
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            // egyenlő távolságú találatoknál az entitás eltérhet
+            if ((a[i].entity == nullptr) != (b[i].entity == nullptr))
+                return false;
+
+            if (std::abs(a[i].distance - b[i].distance) > 1e-4f)
+                return false;
+        }
+
+        return true;
+    }
+}
+
+void RunCollisionBatchBenchmark()
+{
+    std::mt19937 random(1234);
+
+    AABBSoA boxes = MakeBarricadeCluster(random);
+
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::vector<glm::vec3> queries(BenchmarkQueryCount);
+    for (glm::vec3& query : queries)
+    {
+        query = glm::vec3(position(random), 1.0f, position(random));
+    }
+
+    const SimdLevel originalLevel = GetSimdLevel();
+    const SimdLevel supported = DetectSimdLevel();
+
+    auto Sphere = [](const glm::vec3& center, const AABBSoA& b, std::size_t first, std::size_t count)
+    {
+        return IntersectSphereVsAABBBatch(center, 0.5f, b, first, count);
+    };
+
+    auto Capsule = [](const glm::vec3& base, const AABBSoA& b, std::size_t first, std::size_t count)
+    {
+        return IntersectCapsuleVsAABBBatch(base, base + glm::vec3(0.0f, 1.0f, 0.0f), 0.5f, b, first, count);
+    };
+
+    std::cout << "Collision batch benchmark (" << BenchmarkBoxCount << " boxes x " << BenchmarkQueryCount << " queries)\n";
+
+    SetSimdLevel(SimdLevel::Scalar);
+    BenchmarkResult sphereReference = Measure(boxes, queries, Sphere);
+    BenchmarkResult capsuleReference = Measure(boxes, queries, Capsule);
+
+    Report("sphere ", SimdLevel::Scalar, sphereReference, sphereReference);
+    Report("capsule", SimdLevel::Scalar, capsuleReference, capsuleReference);
+
+    for (SimdLevel level : { SimdLevel::SSE, SimdLevel::AVX2 })
+    {
+        if (static_cast<int>(level) > static_cast<int>(supported))
+            break;
+
+        SetSimdLevel(level);
+        Report("sphere ", level, Measure(boxes, queries, Sphere), sphereReference);
+        Report("capsule", level, Measure(boxes, queries, Capsule), capsuleReference);
+    }
+
+    SetSimdLevel(originalLevel);
+}
+
+void RunRaycastBenchmark()
+{
+    std::mt19937 random(4321);
+
+    AABBSoA boxes = MakeBarricadeCluster(random);
+
+    // a barikádok statikusak, a zombik dinamikus kapszulák
+    std::vector<Entity> entities(boxes.Size() + RaycastZombieCount);
+
+    for (std::size_t i = 0; i < boxes.Size(); ++i)
+    {
+        AABB box = boxes.Get(i);
+
+        Entity& entity = entities[i];
+        entity.mobility = Mobility::Static;
+        entity.transform.position = (box.min + box.max) * 0.5f;
+        entity.collision.type = CollisionShape::Type::AABB;
+        entity.collision.halfExtents = (box.max - box.min) * 0.5f;
+    }
+
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+
+    for (std::size_t i = boxes.Size(); i < entities.size(); ++i)
+    {
+        Entity& entity = entities[i];
+        entity.transform.position = glm::vec3(position(random), 0.0f, position(random));
+        entity.collision.type = CollisionShape::Type::Capsule;
+        entity.collision.capsule.radius = 0.3f;
+        entity.collision.capsule.height = 1.8f;
+    }
+
+    CollisionWorld world(4.0f);
+    for (Entity& entity : entities)
+    {
+        world.Add(&entity);
+    }
+
+    // hitscan lövések: a pálya széléről véletlen irányba
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::vector<Ray> rays(RaycastRayCount);
+
+    for (Ray& ray : rays)
+    {
+        float yaw = angle(random);
+        ray.origin = glm::vec3(std::cos(yaw) * 12.0f, 1.5f, std::sin(yaw) * 12.0f);
+
+        float target = angle(random);
+        glm::vec3 toTarget = glm::vec3(std::cos(target) * 5.0f, 1.0f, std::sin(target) * 5.0f) - ray.origin;
+        ray.direction = glm::normalize(toTarget);
+        ray.maxDistance = 40.0f;
+    }
+
+    const SimdLevel originalLevel = GetSimdLevel();
+    const SimdLevel supported = DetectSimdLevel();
+
+    std::cout << "Raycast benchmark (" << entities.size() << " entities x " << RaycastRayCount << " rays)\n";
+
+    std::vector<RaycastHit> reference(rays.size());
+    std::vector<RaycastHit> hits(rays.size());
+
+    world.SetBroadphaseMode(BroadphaseMode::LinearScan);
+    const double referenceSeconds = MeasureRaycast(world, rays, reference);
+
+    std::size_t hitCount = 0;
+    for (const RaycastHit& hit : reference)
+    {
+        hitCount += hit.entity != nullptr ? 1 : 0;
+    }
+
+    std::cout << "  linear scan: " << RaycastRayCount / referenceSeconds / 1.0e6 << " Mray/s, " << hitCount << " hits\n";
+
+    world.SetBroadphaseMode(BroadphaseMode::AabbTree);
+
+    for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::SSE, SimdLevel::AVX2 })
+    {
+        if (static_cast<int>(level) > static_cast<int>(supported))
+            break;
+
+        SetSimdLevel(level);
+        const double seconds = MeasureRaycast(world, rays, hits);
+
+        std::cout
+            << "  tree packet [" << GetSimdLevelName(level) << "]: "
+            << RaycastRayCount / seconds / 1.0e6 << " Mray/s, x" << referenceSeconds / seconds
+            << (SameHits(hits, reference) ? "" : "  MISMATCH")
+            << "\n";
+    }
+
+    SetSimdLevel(originalLevel);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+#ifdef ENGINE_BENCHMARKS
+
+// Skalár és SIMD batch kapszula/gömb vs AABB tesztek áteresztőképessége.
+// Az eredményt a konzolra írja, és ellenőrzi, hogy a maszkok egyeznek.
+void RunCollisionBatchBenchmark();
+
+// Batched raycast: lineáris referencia vs. AABB fa sugárcsomagokkal,
+// minden támogatott SIMD szinten. Ellenőrzi, hogy a találatok egyeznek.
+void RunRaycastBenchmark();
+
+#endif
\ No newline at end of file
@@ -14,6 +14,7 @@ struct CollisionShape
     {
         None,
         AABB,
+        OBB,     // a Transform forgatását követő doboz
         Sphere,
         Capsule
     };
@@ -23,7 +24,7 @@ struct CollisionShape
     // közös
     glm::vec3 localOffset = glm::vec3(0.0f);
 
-    // AABB
+    // AABB / OBB
     glm::vec3 halfExtents = glm::vec3(0.0f);
 
     // Sphere / Capsule
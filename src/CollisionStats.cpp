@@ -0,0 +1,106 @@
+#include "CollisionStats.h"
+
+#ifdef ENGINE_DEBUG
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <iterator>
+
+namespace
+{
+    // A rendszerek munkaszálakon is futnak, ezért az aktuális képkocka
+    // számlálói atomikusak; a sorrend nem számít, elég a relaxed növelés
+    struct AtomicFrameStats
+    {
+        std::atomic<std::uint64_t> counters[static_cast<int>(CollisionCounter::Count)] = {};
+        std::atomic<double> milliseconds[static_cast<int>(CollisionTimer::Count)] = {};
+    };
+
+    AtomicFrameStats currentFrame;
+    CollisionFrameStats lastFrame;
+    CollisionFrameStats peakFrame;
+
+    const char* CounterNames[] =
+    {
+        "broadphase queries",
+        "broadphase candidates",
+        "narrowphase tests",
+        "narrowphase hits",
+        "rays"
+    };
+
+    const char* TimerNames[] =
+    {
+        "player movement",
+        "camera collision",
+        "raycast"
+    };
+
+    static_assert(std::size(CounterNames) == static_cast<std::size_t>(CollisionCounter::Count));
+    static_assert(std::size(TimerNames) == static_cast<std::size_t>(CollisionTimer::Count));
+}
+
+namespace CollisionStats
+{
+    void Increment(CollisionCounter counter, std::uint64_t amount)
+    {
+        currentFrame.counters[static_cast<int>(counter)].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    void AddTime(CollisionTimer timer, double milliseconds)
+    {
+        currentFrame.milliseconds[static_cast<int>(timer)].fetch_add(milliseconds, std::memory_order_relaxed);
+    }
+
+    void EndFrame()
+    {
+        for (int i = 0; i < static_cast<int>(CollisionCounter::Count); ++i)
+        {
+            lastFrame.counters[i] = currentFrame.counters[i].exchange(0, std::memory_order_relaxed);
+            peakFrame.counters[i] = std::max(peakFrame.counters[i], lastFrame.counters[i]);
+        }
+
+        for (int i = 0; i < static_cast<int>(CollisionTimer::Count); ++i)
+        {
+            lastFrame.milliseconds[i] = currentFrame.milliseconds[i].exchange(0.0, std::memory_order_relaxed);
+            peakFrame.milliseconds[i] = std::max(peakFrame.milliseconds[i], lastFrame.milliseconds[i]);
+        }
+    }
+
+    const CollisionFrameStats& GetLastFrame()
+    {
+        return lastFrame;
+    }
+
+    void PrintReport()
+    {
+        std::cout << "Collision stats (last frame / peak)\n";
+
+        for (int i = 0; i < static_cast<int>(CollisionCounter::Count); ++i)
+        {
+            std::cout << "  " << CounterNames[i] << ": " << lastFrame.counters[i] << " / " << peakFrame.counters[i] << "\n";
+        }
+
+        for (int i = 0; i < static_cast<int>(CollisionTimer::Count); ++i)
+        {
+            std::cout << "  " << TimerNames[i] << ": " << lastFrame.milliseconds[i] << " ms / " << peakFrame.milliseconds[i] << " ms\n";
+        }
+
+        peakFrame = CollisionFrameStats{};
+    }
+}
+
+ScopedCollisionTimer::ScopedCollisionTimer(CollisionTimer timer)
+    : timer(timer),
+    start(std::chrono::steady_clock::now())
+{
+}
+
+ScopedCollisionTimer::~ScopedCollisionTimer()
+{
+    auto end = std::chrono::steady_clock::now();
+    CollisionStats::AddTime(timer, std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+#endif
\ No newline at end of file
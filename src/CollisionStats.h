@@ -0,0 +1,80 @@
+#pragma once
+
+// Ütközési lekérdezések számlálói és időmérői. Csak ENGINE_DEBUG alatt
+// léteznek, release buildben a makrók üresek, így semmibe sem kerülnek.
+
+#ifdef ENGINE_DEBUG
+
+#include <chrono>
+#include <cstdint>
+
+enum class CollisionCounter
+{
+    BroadphaseQueries,
+    BroadphaseCandidates,  // a broadphase által visszaadott entitások
+    NarrowphaseTests,
+    NarrowphaseHits,
+    Rays,
+
+    Count
+};
+
+enum class CollisionTimer
+{
+    PlayerMovement,
+    CameraCollision,
+    Raycast,
+
+    Count
+};
+
+struct CollisionFrameStats
+{
+    std::uint64_t counters[static_cast<int>(CollisionCounter::Count)] = {};
+    double milliseconds[static_cast<int>(CollisionTimer::Count)] = {};
+};
+
+namespace CollisionStats
+{
+    // Bármelyik szálról hívható
+    void Increment(CollisionCounter counter, std::uint64_t amount = 1);
+    void AddTime(CollisionTimer timer, double milliseconds);
+
+    // A képkocka végén, a fő szálon hívandó: lezárja az aktuális képkockát és nullázza a számlálókat
+    void EndFrame();
+
+    const CollisionFrameStats& GetLastFrame();
+
+    // Az utolsó képkocka és a legutóbbi kiírás óta mért csúcsértékek a konzolra
+    void PrintReport();
+}
+
+// A hatókör végéig eltelt időt adja a megadott időmérőhöz
+class ScopedCollisionTimer
+{
+public:
+    explicit ScopedCollisionTimer(CollisionTimer timer);
+    ~ScopedCollisionTimer();
+
+    ScopedCollisionTimer(const ScopedCollisionTimer&) = delete;
+    ScopedCollisionTimer& operator=(const ScopedCollisionTimer&) = delete;
+
+private:
+    CollisionTimer timer;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define ZS_COLLISION_CONCAT_INNER(a, b) a##b
+#define ZS_COLLISION_CONCAT(a, b) ZS_COLLISION_CONCAT_INNER(a, b)
+
+#define ZS_COLLISION_COUNT(counter) CollisionStats::Increment(CollisionCounter::counter)
+#define ZS_COLLISION_COUNT_N(counter, amount) CollisionStats::Increment(CollisionCounter::counter, (amount))
+#define ZS_COLLISION_TIMER(timer) ScopedCollisionTimer ZS_COLLISION_CONCAT(collisionTimer, __LINE__)(CollisionTimer::timer)
+
+#else
+
+#define ZS_COLLISION_COUNT(counter) ((void)0)
+#define ZS_COLLISION_COUNT_N(counter, amount) ((void)0)
+#define ZS_COLLISION_TIMER(timer) ((void)0)
+
+#endif
\ No newline at end of file
@@ -1,4 +1,8 @@
 #include "CollisionSystem.h"
+#include "CollisionStats.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <glm/common.hpp>
 #include <glm/geometric.hpp>
 
@@ -13,7 +17,13 @@ bool IntersectSphereVsAABB(const glm::vec3& sphereCenter, float sphereRadius, co
 
     glm::vec3 delta = sphereCenter - closestPoint;
 
-    return glm::dot(delta, delta) <= sphereRadius * sphereRadius;
+    ZS_COLLISION_COUNT(NarrowphaseTests);
+
+    bool hit = glm::dot(delta, delta) <= sphereRadius * sphereRadius;
+    if (hit)
+        ZS_COLLISION_COUNT(NarrowphaseHits);
+
+    return hit;
 }
 
 static float Clamp(float v, float minV, float maxV)
@@ -45,7 +55,14 @@ bool IntersectCapsuleVsAABB(const glm::vec3& capsuleBase, const glm::vec3& capsu
     };
 
     glm::vec3 delta = closestPoint - clamped;
-    return glm::dot(delta, delta) <= capsuleRadius * capsuleRadius;
+
+    ZS_COLLISION_COUNT(NarrowphaseTests);
+
+    bool hit = glm::dot(delta, delta) <= capsuleRadius * capsuleRadius;
+    if (hit)
+        ZS_COLLISION_COUNT(NarrowphaseHits);
+
+    return hit;
 }
 
 bool IntersectSphereVsCapsule(
@@ -62,4 +79,589 @@ bool IntersectSphereVsCapsule(
     float combinedRadius = sphereRadius + capsuleRadius;
 
     return glm::dot(delta, delta) <= combinedRadius * combinedRadius;
+}
+
+// Pont sprse [0, 1] paramterrel gmb ellen (t: belps ideje)
+static bool SweepPointVsSphere(
+    const glm::vec3& start,
+    const glm::vec3& displacement,
+    const glm::vec3& center,
+    float radius,
+    float& outTime)
+{
+    glm::vec3 m = start - center;
+    float b = glm::dot(m, displacement);
+    float c = glm::dot(m, m) - radius * radius;
+
+    if (c <= 0.0f)
+    {
+        outTime = 0.0f;
+        return true;
+    }
+
+    // kvlrl indul s tvolodik
+    if (b > 0.0f)
+        return false;
+
+    float a = glm::dot(displacement, displacement);
+    float discriminant = b * b - a * c;
+
+    if (a <= 0.0f || discriminant < 0.0f)
+        return false;
+
+    outTime = (-b - std::sqrt(discriminant)) / a;
+    return outTime <= 1.0f;
+}
+
+// Pont sprse kapszula (szakasz + sugr) ellen
+static bool SweepPointVsCapsule(
+    const glm::vec3& start,
+    const glm::vec3& displacement,
+    const glm::vec3& segmentStart,
+    const glm::vec3& segmentEnd,
+    float radius,
+    float& outTime)
+{
+    glm::vec3 closest = ClosestPointOnSegment(segmentStart, segmentEnd, start);
+    glm::vec3 delta = start - closest;
+
+    if (glm::dot(delta, delta) <= radius * radius)
+    {
+        outTime = 0.0f;
+        return true;
+    }
+
+    bool hit = false;
+    float time;
+
+    // Henger palst: a tengelyre merleges komponensekre msodfok egyenlet
+    glm::vec3 axis = segmentEnd - segmentStart;
+    float axisLength2 = glm::dot(axis, axis);
+
+    if (axisLength2 > 0.0f)
+    {
+        glm::vec3 fromStart = start - segmentStart;
+        float m = glm::dot(fromStart, axis) / axisLength2;
+        float n = glm::dot(displacement, axis) / axisLength2;
+
+        glm::vec3 q = displacement - axis * n;
+        glm::vec3 r = fromStart - axis * m;
+
+        float a = glm::dot(q, q);
+        float b = glm::dot(q, r);
+        float c = glm::dot(r, r) - radius * radius;
+        float discriminant = b * b - a * c;
+
+        if (a > 1e-12f && discriminant >= 0.0f)
+        {
+            float t = (-b - std::sqrt(discriminant)) / a;
+            float s = m + n * t;
+
+            if (t >= 0.0f && t <= 1.0f && s >= 0.0f && s <= 1.0f)
+            {
+                hit = true;
+                outTime = t;
+            }
+        }
+    }
+
+    // Vgsapkk
+    if (SweepPointVsSphere(start, displacement, segmentStart, radius, time) && (!hit || time < outTime))
+    {
+        hit = true;
+        outTime = time;
+    }
+
+    if (SweepPointVsSphere(start, displacement, segmentEnd, radius, time) && (!hit || time < outTime))
+    {
+        hit = true;
+        outTime = time;
+    }
+
+    return hit;
+}
+
+bool SweepSphereVsAABB(
+    const glm::vec3& sphereStart,
+    const glm::vec3& displacement,
+    float sphereRadius,
+    const AABB& box,
+    float& outTime,
+    glm::vec3& outNormal)
+{
+    // Minkowski-sszeg: a dobozt a sugrral felfjjuk, a gmb kzppontja sugr lesz.
+    const glm::vec3 inflatedMin = box.min - glm::vec3(sphereRadius);
+    const glm::vec3 inflatedMax = box.max + glm::vec3(sphereRadius);
+
+    float tEnter = 0.0f;
+    float tExit = 1.0f;
+    int enterAxis = -1;
+    float enterSign = 0.0f;
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (std::abs(displacement[axis]) < 1e-8f)
+        {
+            if (sphereStart[axis] < inflatedMin[axis] || sphereStart[axis] > inflatedMax[axis])
+                return false;
+
+            continue;
+        }
+
+        const float inverse = 1.0f / displacement[axis];
+        float t1 = (inflatedMin[axis] - sphereStart[axis]) * inverse;
+        float t2 = (inflatedMax[axis] - sphereStart[axis]) * inverse;
+
+        // a belp lap normlja a mozgssal szemben nz
+        float sign = -1.0f;
+        if (t1 > t2)
+        {
+            std::swap(t1, t2);
+            sign = 1.0f;
+        }
+
+        if (t1 > tEnter)
+        {
+            tEnter = t1;
+            enterAxis = axis;
+            enterSign = sign;
+        }
+
+        tExit = std::min(tExit, t2);
+
+        if (tEnter > tExit)
+            return false;
+    }
+
+    // l- vagy cscsrgiban a Minkowski-sszeg valjban lekerektett:
+    // ott a doboz leihez tartoz kapszulkkal szmolunk pontosan
+    const glm::vec3 entryPoint = sphereStart + displacement * tEnter;
+
+    glm::vec3 corner = box.min;
+    int outsideMask = 0;
+    int outsideCount = 0;
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (entryPoint[axis] < box.min[axis])
+        {
+            corner[axis] = box.min[axis];
+        }
+        else if (entryPoint[axis] > box.max[axis])
+        {
+            corner[axis] = box.max[axis];
+        }
+        else
+        {
+            continue;
+        }
+
+        outsideMask |= 1 << axis;
+        ++outsideCount;
+    }
+
+    if (outsideCount >= 2)
+    {
+        bool hit = false;
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            // lrgiban csak a rgi sajt lt, cscsrgiban mindhrmat
+            if (outsideCount == 2 && (outsideMask & (1 << axis)) != 0)
+                continue;
+
+            glm::vec3 edgeStart = corner;
+            glm::vec3 edgeEnd = corner;
+            edgeStart[axis] = box.min[axis];
+            edgeEnd[axis] = box.max[axis];
+
+            float time;
+            if (!SweepPointVsCapsule(sphereStart, displacement, edgeStart, edgeEnd, sphereRadius, time))
+                continue;
+
+            if (hit && time >= outTime)
+                continue;
+
+            hit = true;
+            outTime = time;
+
+            glm::vec3 contact = sphereStart + displacement * time;
+            glm::vec3 normal = contact - ClosestPointOnSegment(edgeStart, edgeEnd, contact);
+            float normalLength = glm::length(normal);
+
+            outNormal = normalLength > 1e-6f ? normal / normalLength : glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+
+        return hit;
+    }
+
+    outTime = tEnter;
+    outNormal = glm::vec3(0.0f);
+
+    if (enterAxis >= 0)
+    {
+        outNormal[enterAxis] = enterSign;
+        return true;
+    }
+
+    // Mr tfedsben indul: a legkisebb behatols tengelye adja a normlt
+    float bestDepth = std::numeric_limits<float>::max();
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const float toMin = sphereStart[axis] - inflatedMin[axis];
+        const float toMax = inflatedMax[axis] - sphereStart[axis];
+
+        if (toMin < bestDepth)
+        {
+            bestDepth = toMin;
+            outNormal = glm::vec3(0.0f);
+            outNormal[axis] = -1.0f;
+        }
+
+        if (toMax < bestDepth)
+        {
+            bestDepth = toMax;
+            outNormal = glm::vec3(0.0f);
+            outNormal[axis] = 1.0f;
+        }
+    }
+
+    return true;
+}
+
+bool SweepCapsuleVsAABB(
+    const glm::vec3& capsuleBase,
+    const glm::vec3& capsuleTip,
+    float capsuleRadius,
+    const glm::vec3& displacement,
+    const AABB& box,
+    float& outTime,
+    glm::vec3& outNormal)
+{
+    // A tengely szakaszt a dobozhoz adjuk (Minkowski), gy a kapszula helyett
+    // az als gmb sprhet. Tengelyirny kapszulnl ez pontos, ferdnl konzervatv.
+    const glm::vec3 axis = capsuleTip - capsuleBase;
+
+    AABB extended =
+    {
+        box.min - glm::max(axis, glm::vec3(0.0f)),
+        box.max - glm::min(axis, glm::vec3(0.0f))
+    };
+
+    return SweepSphereVsAABB(capsuleBase, displacement, capsuleRadius, extended, outTime, outNormal);
+}
+
+bool RaycastAABB(
+    const glm::vec3& origin,
+    const glm::vec3& direction,
+    float maxDistance,
+    const AABB& box,
+    float& outDistance,
+    glm::vec3& outNormal)
+{
+    float tEnter = 0.0f;
+    float tExit = maxDistance;
+    int enterAxis = -1;
+    float enterSign = 0.0f;
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (std::abs(direction[axis]) < 1e-8f)
+        {
+            if (origin[axis] < box.min[axis] || origin[axis] > box.max[axis])
+                return false;
+
+            continue;
+        }
+
+        const float inverse = 1.0f / direction[axis];
+        float t1 = (box.min[axis] - origin[axis]) * inverse;
+        float t2 = (box.max[axis] - origin[axis]) * inverse;
+
+        float sign = -1.0f;
+        if (t1 > t2)
+        {
+            std::swap(t1, t2);
+            sign = 1.0f;
+        }
+
+        if (t1 > tEnter)
+        {
+            tEnter = t1;
+            enterAxis = axis;
+            enterSign = sign;
+        }
+
+        tExit = std::min(tExit, t2);
+
+        if (tEnter > tExit)
+            return false;
+    }
+
+    outDistance = tEnter;
+    outNormal = glm::vec3(0.0f);
+
+    // dobozon bellrl indul: a sugrral szembe mutat norml
+    if (enterAxis < 0)
+        outNormal = -direction;
+    else
+        outNormal[enterAxis] = enterSign;
+
+    return true;
+}
+
+bool RaycastSphere(
+    const glm::vec3& origin,
+    const glm::vec3& direction,
+    float maxDistance,
+    const glm::vec3& sphereCenter,
+    float sphereRadius,
+    float& outDistance,
+    glm::vec3& outNormal)
+{
+    float time;
+    if (!SweepPointVsSphere(origin, direction * maxDistance, sphereCenter, sphereRadius, time))
+        return false;
+
+    outDistance = time * maxDistance;
+
+    glm::vec3 normal = origin + direction * outDistance - sphereCenter;
+    float normalLength = glm::length(normal);
+    outNormal = normalLength > 1e-6f ? normal / normalLength : -direction;
+
+    return true;
+}
+
+bool RaycastCapsule(
+    const glm::vec3& origin,
+    const glm::vec3& direction,
+    float maxDistance,
+    const glm::vec3& capsuleBase,
+    const glm::vec3& capsuleTip,
+    float capsuleRadius,
+    float& outDistance,
+    glm::vec3& outNormal)
+{
+    float time;
+    if (!SweepPointVsCapsule(origin, direction * maxDistance, capsuleBase, capsuleTip, capsuleRadius, time))
+        return false;
+
+    outDistance = time * maxDistance;
+
+    glm::vec3 point = origin + direction * outDistance;
+    glm::vec3 normal = point - ClosestPointOnSegment(capsuleBase, capsuleTip, point);
+    float normalLength = glm::length(normal);
+    outNormal = normalLength > 1e-6f ? normal / normalLength : -direction;
+
+    return true;
+}
+
+// A szakasz s a doboz tvolsgngyzete. f(t) konvex s szakaszonknt
+// msodfok, trspontjai ott vannak, ahol egy koordinta tlpi a doboz
+// egy lapjt: minden darabon a parabola minimumt nzzk.
+static float SquaredDistanceSegmentAABB(const glm::vec3& a, const glm::vec3& b, const AABB& box)
+{
+    const glm::vec3 direction = b - a;
+
+    auto DistanceAt = [&](float t)
+    {
+        const glm::vec3 point = a + direction * t;
+        const glm::vec3 delta = point - glm::clamp(point, box.min, box.max);
+        return glm::dot(delta, delta);
+    };
+
+    float breaks[8] = { 0.0f, 1.0f };
+    int breakCount = 2;
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (std::abs(direction[axis]) < 1e-8f)
+            continue;
+
+        for (float bound : { box.min[axis], box.max[axis] })
+        {
+            const float t = (bound - a[axis]) / direction[axis];
+            if (t > 0.0f && t < 1.0f)
+                breaks[breakCount++] = t;
+        }
+    }
+
+    std::sort(breaks, breaks + breakCount);
+
+    float best = std::numeric_limits<float>::max();
+
+    for (int i = 0; i + 1 < breakCount; ++i)
+    {
+        const float t0 = breaks[i];
+        const float t1 = breaks[i + 1];
+        const glm::vec3 middle = a + direction * ((t0 + t1) * 0.5f);
+
+        // a darabon a dobozon kvli tengelyek adjk a parabolt
+        float quadratic = 0.0f;
+        float linear = 0.0f;
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float bound;
+            if (middle[axis] < box.min[axis])
+                bound = box.min[axis];
+            else if (middle[axis] > box.max[axis])
+                bound = box.max[axis];
+            else
+                continue;
+
+            quadratic += direction[axis] * direction[axis];
+            linear += 2.0f * direction[axis] * (a[axis] - bound);
+        }
+
+        const float t = quadratic > 0.0f ? Clamp(-linear / (2.0f * quadratic), t0, t1) : t0;
+        best = std::min(best, DistanceAt(t));
+    }
+
+    return std::min({ best, DistanceAt(0.0f), DistanceAt(1.0f) });
+}
+
+bool IntersectSphereVsOBB(const glm::vec3& sphereCenter, float sphereRadius, const OBB& box)
+{
+    glm::vec3 delta = sphereCenter - box.center;
+    float distanceSquared = 0.0f;
+
+    // tengelyenknt: ha egy tengelyen mr sugrnl messzebb van, nincs metszs
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        float excess = std::abs(glm::dot(delta, box.axes[axis])) - box.halfExtents[axis];
+
+        if (excess > sphereRadius)
+            return false;
+
+        if (excess > 0.0f)
+            distanceSquared += excess * excess;
+    }
+
+    return distanceSquared <= sphereRadius * sphereRadius;
+}
+
+bool IntersectCapsuleVsOBB(const glm::vec3& capsuleBase, const glm::vec3& capsuleTip, float capsuleRadius, const OBB& box)
+{
+    const glm::vec3 localBase = ToOBBLocalPoint(box, capsuleBase);
+    const glm::vec3 localTip = ToOBBLocalPoint(box, capsuleTip);
+
+    // SAT korai kilps a doboz tengelyein: a szakasz vetlete sugrral bvtve
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        float low = std::min(localBase[axis], localTip[axis]) - capsuleRadius;
+        float high = std::max(localBase[axis], localTip[axis]) + capsuleRadius;
+
+        if (low > box.halfExtents[axis] || high < -box.halfExtents[axis])
+            return false;
+    }
+
+    // SAT a kapszula tengelyn
+    glm::vec3 segment = localTip - localBase;
+    float segmentLength = glm::length(segment);
+
+    if (segmentLength > 1e-6f)
+    {
+        glm::vec3 direction = segment / segmentLength;
+
+        float boxRadius = glm::dot(glm::abs(direction), box.halfExtents);
+        float boxCenter = glm::dot(-localBase, direction);
+
+        if (boxCenter + boxRadius < -capsuleRadius || boxCenter - boxRadius > segmentLength + capsuleRadius)
+            return false;
+    }
+
+    // helyi trben a doboz tengelyigaztott: a tengely s a doboz pontos tvolsga
+    return SquaredDistanceSegmentAABB(localBase, localTip, { -box.halfExtents, box.halfExtents }) <= capsuleRadius * capsuleRadius;
+}
+
+bool SweepSphereVsOBB(
+    const glm::vec3& sphereStart,
+    const glm::vec3& displacement,
+    float sphereRadius,
+    const OBB& box,
+    float& outTime,
+    glm::vec3& outNormal)
+{
+    // a sprt gmb egy kapszula: ha az sem metszi a dobozt, a sprs sem tall
+    if (!IntersectCapsuleVsOBB(sphereStart, sphereStart + displacement, sphereRadius, box))
+        return false;
+
+    glm::vec3 localNormal;
+
+    if (!SweepSphereVsAABB(
+        ToOBBLocalPoint(box, sphereStart),
+        ToOBBLocalDirection(box, displacement),
+        sphereRadius,
+        { -box.halfExtents, box.halfExtents },
+        outTime,
+        localNormal))
+    {
+        return false;
+    }
+
+    outNormal = FromOBBLocalDirection(box, localNormal);
+    return true;
+}
+
+bool SweepCapsuleVsOBB(
+    const glm::vec3& capsuleBase,
+    const glm::vec3& capsuleTip,
+    float capsuleRadius,
+    const glm::vec3& displacement,
+    const OBB& box,
+    float& outTime,
+    glm::vec3& outNormal)
+{
+    // A sprt kapszula a (base, tip, displacement) paralelogramma sugrral
+    // felfjva; a paralelogramma befoglal gmbjvel gyors SAT kizrs
+    const glm::vec3 axis = capsuleTip - capsuleBase;
+    const glm::vec3 sweptCenter = capsuleBase + (axis + displacement) * 0.5f;
+    const float sweptRadius = 0.5f * std::max(glm::length(axis + displacement), glm::length(axis - displacement));
+
+    if (!IntersectSphereVsOBB(sweptCenter, capsuleRadius + sweptRadius, box))
+        return false;
+
+    glm::vec3 localNormal;
+
+    if (!SweepCapsuleVsAABB(
+        ToOBBLocalPoint(box, capsuleBase),
+        ToOBBLocalPoint(box, capsuleTip),
+        capsuleRadius,
+        ToOBBLocalDirection(box, displacement),
+        { -box.halfExtents, box.halfExtents },
+        outTime,
+        localNormal))
+    {
+        return false;
+    }
+
+    outNormal = FromOBBLocalDirection(box, localNormal);
+    return true;
+}
+
+bool RaycastOBB(
+    const glm::vec3& origin,
+    const glm::vec3& direction,
+    float maxDistance,
+    const OBB& box,
+    float& outDistance,
+    glm::vec3& outNormal)
+{
+    glm::vec3 localNormal;
+
+    if (!RaycastAABB(
+        ToOBBLocalPoint(box, origin),
+        ToOBBLocalDirection(box, direction),
+        maxDistance,
+        { -box.halfExtents, box.halfExtents },
+        outDistance,
+        localNormal))
+    {
+        return false;
+    }
+
+    outNormal = FromOBBLocalDirection(box, localNormal);
+    return true;
 }
\ No newline at end of file
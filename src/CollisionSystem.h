@@ -3,6 +3,7 @@
 #include <vector>
 #include <glm/vec3.hpp>
 #include "AABB.h"
+#include "OBB.h"
 
 bool IntersectSphereVsAABB(const glm::vec3& sphereCenter, float sphereRadius, const AABB& box);
 
@@ -17,4 +18,89 @@ bool IntersectSphereVsCapsule(
     float sphereRadius,
     const glm::vec3& capsuleBase,
     const glm::vec3& capsuleTip,
-    float capsuleRadius);
\ No newline at end of file
+    float capsuleRadius);
+
+// A gömb a sphereStart-tól sphereStart + displacement-ig mozog. Találat esetén
+// outTime a legkorábbi érintkezés [0, 1]-ben, outNormal a doboz felületi normálja.
+bool SweepSphereVsAABB(
+    const glm::vec3& sphereStart,
+    const glm::vec3& displacement,
+    float sphereRadius,
+    const AABB& box,
+    float& outTime,
+    glm::vec3& outNormal);
+
+// Kapszula söprése displacement mentén. Függőleges (tengelyirányú) kapszulára pontos.
+bool SweepCapsuleVsAABB(
+    const glm::vec3& capsuleBase,
+    const glm::vec3& capsuleTip,
+    float capsuleRadius,
+    const glm::vec3& displacement,
+    const AABB& box,
+    float& outTime,
+    glm::vec3& outNormal);
+
+// Sugár tesztek: direction egységvektor, a találat távolsága [0, maxDistance]-ben.
+// Ha a sugár az alakzaton belül indul, a távolság 0 és a normál -direction.
+bool RaycastAABB(
+    const glm::vec3& origin,
+    const glm::vec3& direction,
+    float maxDistance,
+    const AABB& box,
+    float& outDistance,
+    glm::vec3& outNormal);
+
+bool RaycastSphere(
+    const glm::vec3& origin,
+    const glm::vec3& direction,
+    float maxDistance,
+    const glm::vec3& sphereCenter,
+    float sphereRadius,
+    float& outDistance,
+    glm::vec3& outNormal);
+
+bool RaycastCapsule(
+    const glm::vec3& origin,
+    const glm::vec3& direction,
+    float maxDistance,
+    const glm::vec3& capsuleBase,
+    const glm::vec3& capsuleTip,
+    float capsuleRadius,
+    float& outDistance,
+    glm::vec3& outNormal);
+
+// OBB tesztek: a doboz helyi terében futnak, így a tengelyigazított tesztekkel
+// azonos eredményt adnak. A kapszula söprése függőleges kapszulára és
+// Y körül forgatott dobozra pontos.
+bool IntersectSphereVsOBB(const glm::vec3& sphereCenter, float sphereRadius, const OBB& box);
+
+bool IntersectCapsuleVsOBB(
+    const glm::vec3& capsuleBase,
+    const glm::vec3& capsuleTip,
+    float capsuleRadius,
+    const OBB& box);
+
+bool SweepSphereVsOBB(
+    const glm::vec3& sphereStart,
+    const glm::vec3& displacement,
+    float sphereRadius,
+    const OBB& box,
+    float& outTime,
+    glm::vec3& outNormal);
+
+bool SweepCapsuleVsOBB(
+    const glm::vec3& capsuleBase,
+    const glm::vec3& capsuleTip,
+    float capsuleRadius,
+    const glm::vec3& displacement,
+    const OBB& box,
+    float& outTime,
+    glm::vec3& outNormal);
+
+bool RaycastOBB(
+    const glm::vec3& origin,
+    const glm::vec3& direction,
+    float maxDistance,
+    const OBB& box,
+    float& outDistance,
+    glm::vec3& outNormal);
\ No newline at end of file
@@ -0,0 +1,271 @@
+#include "CollisionWorld.h"
+#include "CollisionSystem.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace
+{
+    // Pontos sugár teszt az entitás alakzatával, bounds a világbeli doboza
+    bool RaycastEntity(
+        const Ray& ray,
+        const Entity& entity,
+        const AABB& bounds,
+        float maxDistance,
+        float& outDistance,
+        glm::vec3& outNormal)
+    {
+        ZS_COLLISION_COUNT(NarrowphaseTests);
+
+        const CollisionShape& shape = entity.collision;
+        const glm::vec3 center = entity.transform.position + shape.localOffset;
+
+        switch (shape.type)
+        {
+        case CollisionShape::Type::Sphere:
+            return RaycastSphere(ray.origin, ray.direction, maxDistance, center, shape.radius, outDistance, outNormal);
+
+        case CollisionShape::Type::Capsule:
+        {
+            // lásd CharacterController::ComputeCapsule
+            const float radius = shape.capsule.radius;
+            const glm::vec3 base = center + glm::vec3(0.0f, radius, 0.0f);
+            const glm::vec3 tip = base + glm::vec3(0.0f, std::max(0.0f, shape.capsule.height - 2.0f * radius), 0.0f);
+
+            return RaycastCapsule(ray.origin, ray.direction, maxDistance, base, tip, radius, outDistance, outNormal);
+        }
+
+        case CollisionShape::Type::OBB:
+            return RaycastOBB(ray.origin, ray.direction, maxDistance, GetWorldOBB(entity), outDistance, outNormal);
+
+        case CollisionShape::Type::None:
+            return false;
+
+        default:
+            return RaycastAABB(ray.origin, ray.direction, maxDistance, bounds, outDistance, outNormal);
+        }
+    }
+}
+
+CollisionWorld::CollisionWorld(float cellSize)
+    : grid(cellSize)
+{
+}
+
+void CollisionWorld::Add(Entity* entity)
+{
+    if (std::find(entities.begin(), entities.end(), entity) != entities.end())
+        return;
+
+    entities.push_back(entity);
+
+    MarkTransformDirty(*entity);
+    const AABB& bounds = GetWorldAABB(*entity);
+
+    if (entity->mobility == Mobility::Static)
+    {
+        staticEntities.push_back(entity);
+        staticBounds.push_back(bounds);
+        staticBoundsSoA.Add(bounds);
+    }
+    else
+    {
+        dynamicEntities.push_back(entity);
+    }
+
+    grid.Insert(entity);
+    treeProxies[entity] = tree.CreateProxy(entity, bounds);
+}
+
+void CollisionWorld::Remove(Entity* entity)
+{
+    auto it = std::find(entities.begin(), entities.end(), entity);
+    if (it == entities.end())
+        return;
+
+    entities.erase(it);
+
+    if (entity->mobility == Mobility::Static)
+    {
+        auto staticIt = std::find(staticEntities.begin(), staticEntities.end(), entity);
+        if (staticIt != staticEntities.end())
+        {
+            // a párhuzamos tömbökből a végével felülírva törlünk
+            const std::size_t index = staticIt - staticEntities.begin();
+            const std::size_t last = staticEntities.size() - 1;
+
+            staticEntities[index] = staticEntities[last];
+            staticBounds[index] = staticBounds[last];
+            staticBoundsSoA.Set(index, staticBounds[last]);
+
+            staticEntities.pop_back();
+            staticBounds.pop_back();
+            staticBoundsSoA.PopBack();
+        }
+    }
+    else
+    {
+        auto dynamicIt = std::find(dynamicEntities.begin(), dynamicEntities.end(), entity);
+        if (dynamicIt != dynamicEntities.end())
+        {
+            *dynamicIt = dynamicEntities.back();
+            dynamicEntities.pop_back();
+        }
+    }
+
+    grid.Remove(entity);
+
+    auto proxy = treeProxies.find(entity);
+    if (proxy != treeProxies.end())
+    {
+        tree.DestroyProxy(proxy->second);
+        treeProxies.erase(proxy);
+    }
+}
+
+void CollisionWorld::Update(Entity* entity)
+{
+    if (entity->mobility == Mobility::Static)
+        return;
+
+    MarkTransformDirty(*entity);
+
+    grid.Update(entity);
+
+    auto proxy = treeProxies.find(entity);
+    if (proxy != treeProxies.end())
+        tree.MoveProxy(proxy->second, GetWorldAABB(*entity));
+}
+
+void CollisionWorld::SetBroadphaseMode(BroadphaseMode newMode)
+{
+    mode = newMode;
+}
+
+BroadphaseMode CollisionWorld::GetBroadphaseMode() const
+{
+    return mode;
+}
+
+const std::vector<Entity*>& CollisionWorld::GetEntities() const
+{
+    return entities;
+}
+
+const std::vector<Entity*>& CollisionWorld::GetStaticEntities() const
+{
+    return staticEntities;
+}
+
+const std::vector<AABB>& CollisionWorld::GetStaticBounds() const
+{
+    return staticBounds;
+}
+
+const AABBSoA& CollisionWorld::GetStaticBoundsSoA() const
+{
+    return staticBoundsSoA;
+}
+
+void CollisionWorld::RaycastBatch(const Ray* rays, std::size_t count, RaycastHit* outHits) const
+{
+    ZS_COLLISION_TIMER(Raycast);
+    ZS_COLLISION_COUNT_N(Rays, count);
+
+    for (std::size_t first = 0; first < count; first += RayPacketSize)
+    {
+        const std::size_t packetCount = std::min(RayPacketSize, count - first);
+        const Ray* packetRays = rays + first;
+        RaycastHit* packetHits = outHits + first;
+
+        for (std::size_t lane = 0; lane < packetCount; ++lane)
+            packetHits[lane] = RaycastHit{};
+
+        if (mode == BroadphaseMode::LinearScan)
+        {
+            for (std::size_t lane = 0; lane < packetCount; ++lane)
+            {
+                const Ray& ray = packetRays[lane];
+                float maxDistance = ray.maxDistance;
+
+                if (maxDistance <= 0.0f)
+                    continue;
+
+                for (Entity* entity : entities)
+                {
+                    float distance;
+                    glm::vec3 normal;
+
+                    if (entity == ray.ignore)
+                        continue;
+
+                    ZS_COLLISION_COUNT(BroadphaseCandidates);
+
+                    if (!RaycastEntity(ray, *entity, GetWorldAABB(*entity), maxDistance, distance, normal))
+                        continue;
+
+                    ZS_COLLISION_COUNT(NarrowphaseHits);
+
+                    packetHits[lane] = { entity, distance, normal };
+                    maxDistance = distance;
+                }
+            }
+
+            continue;
+        }
+
+        RayPacket packet;
+        packet.Clear();
+
+        std::uint32_t activeMask = 0;
+
+        for (std::size_t lane = 0; lane < packetCount; ++lane)
+        {
+            const Ray& ray = packetRays[lane];
+
+            if (ray.maxDistance <= 0.0f)
+                continue;
+
+            packet.Set(lane, ray.origin, ray.direction, ray.maxDistance);
+            activeMask |= 1u << lane;
+        }
+
+        ZS_COLLISION_COUNT(BroadphaseQueries);
+
+        tree.RayCastPacket(packet, activeMask, [&](Entity* entity, const AABB& bounds, std::uint32_t rayMask)
+        {
+            while (rayMask != 0)
+            {
+                const int lane = std::countr_zero(rayMask);
+                rayMask &= rayMask - 1;
+
+                const Ray& ray = packetRays[lane];
+
+                if (entity == ray.ignore)
+                    continue;
+
+                ZS_COLLISION_COUNT(BroadphaseCandidates);
+
+                float distance;
+                glm::vec3 normal;
+
+                if (!RaycastEntity(ray, *entity, bounds, packet.maxDistance[lane], distance, normal))
+                    continue;
+
+                ZS_COLLISION_COUNT(NarrowphaseHits);
+
+                // a sugár innentől csak a közelebbi csomópontokat nézi
+                packetHits[lane] = { entity, distance, normal };
+                packet.maxDistance[lane] = distance;
+            }
+        });
+    }
+}
+
+RaycastHit CollisionWorld::Raycast(const Ray& ray) const
+{
+    RaycastHit hit;
+    RaycastBatch(&ray, 1, &hit);
+
+    return hit;
+}
\ No newline at end of file
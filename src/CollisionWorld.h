@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+#include <glm/common.hpp>
+#include "AABB.h"
+#include "AabbTree.h"
+#include "CollisionBatch.h"
+#include "CollisionStats.h"
+#include "Entity.h"
+#include "PlayerCollision.h"
+#include "SpatialHashGrid.h"
+
+enum class BroadphaseMode
+{
+    LinearScan,     // referencia: minden entitást végignéz
+    SpatialHashGrid,
+    AabbTree        // nem egyenletes, nagy pályákhoz
+};
+
+struct Ray
+{
+    glm::vec3 origin = glm::vec3(0.0f);
+    glm::vec3 direction = glm::vec3(0.0f, 0.0f, -1.0f); // egységvektor
+    float maxDistance = 0.0f;
+
+    const Entity* ignore = nullptr; // pl. a lövő vagy a néző zombi saját maga
+};
+
+struct RaycastHit
+{
+    Entity* entity = nullptr; // nullptr: nincs találat
+    float distance = 0.0f;
+    glm::vec3 normal = glm::vec3(0.0f);
+};
+
+// A világ ütközési entitásai és a hozzájuk tartozó broadphase.
+class CollisionWorld
+{
+public:
+    explicit CollisionWorld(float cellSize);
+
+    void Add(Entity* entity);
+    void Remove(Entity* entity);
+
+    // Dinamikus entitás mozgása után hívandó: érvényteleníti a gyorsítótárazott
+    // határoló dobozt, és frissíti a broadphase-t. Statikus entitásnál nem csinál semmit.
+    void Update(Entity* entity);
+
+    void SetBroadphaseMode(BroadphaseMode mode);
+    BroadphaseMode GetBroadphaseMode() const;
+
+    const std::vector<Entity*>& GetEntities() const;
+
+    // A statikus entitások dobozai egy folytonos tömbben (és SoA-ban a batch
+    // kernelekhez), az i. doboz a GetStaticEntities()[i]-hez tartozik
+    const std::vector<Entity*>& GetStaticEntities() const;
+    const std::vector<AABB>& GetStaticBounds() const;
+    const AABBSoA& GetStaticBoundsSoA() const;
+
+    // bool callback(Entity* entity, const AABB& bounds), false -> leállás
+    template <typename Callback>
+    void QueryAABB(const AABB& box, Callback&& callback) const;
+
+    // Az AABB-vel közelített alakzat söprése displacement mentén.
+    // bool callback(Entity* entity, const AABB& bounds), false -> leállás
+    template <typename Callback>
+    void QuerySwept(const AABB& shapeBounds, const glm::vec3& displacement, Callback&& callback) const;
+
+    // Sugarankénti legközelebbi találat (hitscan, látóvonal). A sugarakat
+    // RayPacketSize-os csomagokban viszi végig az AABB fán, a grid módban is.
+    // LinearScan módban minden entitást végignéz (referencia).
+    void RaycastBatch(const Ray* rays, std::size_t count, RaycastHit* outHits) const;
+
+    RaycastHit Raycast(const Ray& ray) const;
+
+private:
+    std::vector<Entity*> entities;
+
+    std::vector<Entity*> staticEntities;
+    std::vector<AABB> staticBounds;
+    AABBSoA staticBoundsSoA;
+
+    std::vector<Entity*> dynamicEntities;
+
+    SpatialHashGrid grid;
+    AabbTree tree;
+    std::unordered_map<const Entity*, int> treeProxies;
+
+    BroadphaseMode mode = BroadphaseMode::SpatialHashGrid;
+};
+
+template <typename Callback>
+void CollisionWorld::QueryAABB(const AABB& box, Callback&& callback) const
+{
+    ZS_COLLISION_COUNT(BroadphaseQueries);
+
+    if (mode == BroadphaseMode::SpatialHashGrid)
+    {
+        grid.QueryAABB(box, callback);
+        return;
+    }
+
+    if (mode == BroadphaseMode::AabbTree)
+    {
+        tree.QueryAABB(box, callback);
+        return;
+    }
+
+    // Referencia mód: a statikus dobozok folytonos tömbjén megy végig,
+    // a dinamikus entitásoknál a gyorsítótárazott dobozt használja
+    for (std::size_t i = 0; i < staticBounds.size(); ++i)
+    {
+        if (!IntersectAABBvsAABB(staticBounds[i], box))
+            continue;
+
+        if (!callback(staticEntities[i], staticBounds[i]))
+            return;
+    }
+
+    for (Entity* entity : dynamicEntities)
+    {
+        const AABB& bounds = GetWorldAABB(*entity);
+
+        if (!IntersectAABBvsAABB(bounds, box))
+            continue;
+
+        if (!callback(entity, bounds))
+            return;
+    }
+}
+
+template <typename Callback>
+void CollisionWorld::QuerySwept(const AABB& shapeBounds, const glm::vec3& displacement, Callback&& callback) const
+{
+    if (mode == BroadphaseMode::AabbTree)
+    {
+        ZS_COLLISION_COUNT(BroadphaseQueries);
+        tree.QuerySwept(shapeBounds, displacement, callback);
+        return;
+    }
+
+    // a többi módban a teljes söpört tartományt kérdezzük le
+    AABB sweptBounds =
+    {
+        glm::min(shapeBounds.min, shapeBounds.min + displacement),
+        glm::max(shapeBounds.max, shapeBounds.max + displacement)
+    };
+
+    QueryAABB(sweptBounds, callback);
+}
\ No newline at end of file
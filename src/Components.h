@@ -0,0 +1,19 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+#include "Transform.h"
+
+// ECS komponensek (Ecs.h). A Transform és a CollisionShape közvetlenül is
+// komponens; itt csak az ECS-hez bevezetett típusok vannak.
+
+// az előző szimulációs lépés állapota, a renderelés ez és a Transform között interpolál
+struct PreviousTransform
+{
+    Transform transform;
+};
+
+struct Renderable
+{
+    glm::vec3 color = glm::vec3(1.0f);
+    bool useVertexColor = false;
+};
\ No newline at end of file
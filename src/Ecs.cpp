@@ -0,0 +1,247 @@
+#include "Ecs.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+    std::atomic<ComponentTypeId> componentTypeCount{ 0 };
+    std::size_t componentSizes[MaxComponentTypes];
+}
+
+ComponentTypeId RegisterComponentType(std::size_t size)
+{
+    const ComponentTypeId type = componentTypeCount++;
+
+    if (type >= MaxComponentTypes)
+    {
+        std::cerr << "Too many ECS component types (max " << MaxComponentTypes << ")\n";
+        std::abort();
+    }
+
+    componentSizes[type] = size;
+    return type;
+}
+
+std::size_t GetComponentSize(ComponentTypeId type)
+{
+    return componentSizes[type];
+}
+
+// ---- Archetype ----
+
+Archetype::Archetype(ComponentMask mask)
+    : mask(mask)
+{
+    std::fill(std::begin(columnLookup), std::end(columnLookup), -1);
+
+    for (ComponentTypeId type = 0; type < MaxComponentTypes; ++type)
+    {
+        if ((mask & (ComponentMask{ 1 } << type)) == 0)
+            continue;
+
+        columnLookup[type] = static_cast<int>(columns.size());
+        columns.push_back({ GetComponentSize(type), {} });
+    }
+}
+
+ComponentMask Archetype::GetMask() const
+{
+    return mask;
+}
+
+std::size_t Archetype::GetSize() const
+{
+    return entities.size();
+}
+
+bool Archetype::Has(ComponentTypeId type) const
+{
+    return columnLookup[type] != -1;
+}
+
+std::byte* Archetype::GetColumn(ComponentTypeId type)
+{
+    assert(Has(type));
+    return columns[columnLookup[type]].data.data();
+}
+
+const EntityHandle* Archetype::GetEntities() const
+{
+    return entities.data();
+}
+
+std::size_t Archetype::AddRow(EntityHandle entity)
+{
+    const std::size_t row = entities.size();
+    entities.push_back(entity);
+
+    // a vektorok kapacitása törléskor megmarad, így itt csak növekedéskor foglalunk
+    for (Column& column : columns)
+    {
+        column.data.resize(column.data.size() + column.elementSize);
+    }
+
+    return row;
+}
+
+std::uint32_t Archetype::RemoveRow(std::size_t row)
+{
+    const std::size_t last = entities.size() - 1;
+    std::uint32_t moved = InvalidEntityIndex;
+
+    if (row != last)
+    {
+        entities[row] = entities[last];
+        moved = entities[row].index;
+
+        for (Column& column : columns)
+        {
+            std::memcpy(column.data.data() + row * column.elementSize, column.data.data() + last * column.elementSize, column.elementSize);
+        }
+    }
+
+    entities.pop_back();
+
+    for (Column& column : columns)
+    {
+        column.data.resize(column.data.size() - column.elementSize);
+    }
+
+    return moved;
+}
+
+void Archetype::CopyRow(std::size_t row, Archetype& target, std::size_t targetRow) const
+{
+    for (ComponentTypeId type = 0; type < MaxComponentTypes; ++type)
+    {
+        if (columnLookup[type] == -1 || target.columnLookup[type] == -1)
+            continue;
+
+        const Column& source = columns[columnLookup[type]];
+        Column& destination = target.columns[target.columnLookup[type]];
+
+        std::memcpy(destination.data.data() + targetRow * destination.elementSize, source.data.data() + row * source.elementSize, source.elementSize);
+    }
+}
+
+// ---- EcsWorld ----
+
+void EcsWorld::Destroy(EntityHandle entity)
+{
+    if (IsAlive(entity))
+    {
+        pendingDestroys.push_back(entity);
+    }
+}
+
+void EcsWorld::FlushDestroyed()
+{
+    // a kétszer sorba állított entitás második törlése már halott handle-re esik
+    for (const EntityHandle& entity : pendingDestroys)
+    {
+        DestroyImmediate(entity);
+    }
+
+    pendingDestroys.clear();
+}
+
+bool EcsWorld::IsAlive(EntityHandle entity) const
+{
+    return
+        entity.index < slots.size() &&
+        slots[entity.index].generation == entity.generation &&
+        slots[entity.index].archetype != InvalidArchetype;
+}
+
+std::size_t EcsWorld::GetEntityCount() const
+{
+    return entityCount;
+}
+
+std::size_t EcsWorld::GetArchetypeCount() const
+{
+    return archetypes.size();
+}
+
+std::size_t EcsWorld::GetPendingDestroyCount() const
+{
+    return pendingDestroys.size();
+}
+
+EntityHandle EcsWorld::AllocateSlot()
+{
+    ++entityCount;
+
+    if (freeSlot != InvalidEntityIndex)
+    {
+        const std::uint32_t index = freeSlot;
+        freeSlot = slots[index].row;
+
+        return { index, slots[index].generation };
+    }
+
+    slots.emplace_back();
+    return { static_cast<std::uint32_t>(slots.size() - 1), 0 };
+}
+
+void EcsWorld::DestroyImmediate(EntityHandle entity)
+{
+    if (!IsAlive(entity))
+        return;
+
+    EntitySlot& slot = slots[entity.index];
+
+    const std::uint32_t moved = archetypes[slot.archetype]->RemoveRow(slot.row);
+    if (moved != InvalidEntityIndex)
+    {
+        slots[moved].row = slot.row;
+    }
+
+    // a generáció növelése érvényteleníti a kint maradt handle-öket
+    slot.archetype = InvalidArchetype;
+    slot.row = freeSlot;
+    ++slot.generation;
+
+    freeSlot = entity.index;
+    --entityCount;
+}
+
+std::uint32_t EcsWorld::GetOrCreateArchetype(ComponentMask mask)
+{
+    auto it = archetypeLookup.find(mask);
+    if (it != archetypeLookup.end())
+        return it->second;
+
+    const std::uint32_t index = static_cast<std::uint32_t>(archetypes.size());
+
+    archetypes.push_back(std::make_unique<Archetype>(mask));
+    archetypeLookup[mask] = index;
+
+    return index;
+}
+
+void EcsWorld::MoveEntity(std::uint32_t index, ComponentMask mask)
+{
+    const std::uint32_t targetIndex = GetOrCreateArchetype(mask);
+
+    EntitySlot& slot = slots[index];
+
+    Archetype& source = *archetypes[slot.archetype];
+    Archetype& target = *archetypes[targetIndex];
+
+    const std::size_t targetRow = target.AddRow(source.GetEntities()[slot.row]);
+    source.CopyRow(slot.row, target, targetRow);
+
+    const std::uint32_t moved = source.RemoveRow(slot.row);
+    if (moved != InvalidEntityIndex)
+    {
+        slots[moved].row = slot.row;
+    }
+
+    slot.archetype = targetIndex;
+    slot.row = static_cast<std::uint32_t>(targetRow);
+}
\ No newline at end of file
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Archetípus alapú ECS. Az azonos komponenskészletű entitások egy
+// archetípusba kerülnek, ahol minden komponens típus egy összefüggő oszlop
+// (structure-of-arrays). A lekérdezés archetípusonként lineárisan halad
+// végig a kért oszlopokon, pointerkövetés nélkül.
+//
+// A komponensek egyszerű adatok (trivially copyable), az archetípusváltás
+// és a törlés bájtonként másol. A törlés a sor helyére az utolsót teszi,
+// így a sorrend nem stabil. Bejárás közben a Destroy biztonságos (csak
+// sorba áll), komponenst hozzáadni/elvenni viszont nem szabad.
+
+constexpr std::uint32_t InvalidEntityIndex = ~std::uint32_t{ 0 };
+
+// Generációs entitás azonosító. Az index a slot, a generáció a slot minden
+// felszabadításakor nő, így egy törölt entitás régi handle-je akkor is
+// érvénytelen marad, ha a slotot már új entitás használja.
+struct EntityHandle
+{
+    std::uint32_t index = InvalidEntityIndex;
+    std::uint32_t generation = 0;
+
+    bool operator==(const EntityHandle&) const = default;
+
+    // egyetlen 64 bites kulcs (hash, rendezés, tárolás)
+    std::uint64_t Pack() const
+    {
+        return (static_cast<std::uint64_t>(generation) << 32) | index;
+    }
+};
+
+using ComponentTypeId = std::uint32_t;
+using ComponentMask = std::uint64_t;
+
+constexpr std::size_t MaxComponentTypes = 64; // a ComponentMask bitjei
+
+// Új komponens típus azonosítója; a GetComponentTypeId hívja típusonként egyszer
+ComponentTypeId RegisterComponentType(std::size_t size);
+std::size_t GetComponentSize(ComponentTypeId type);
+
+template <typename T>
+ComponentTypeId GetComponentTypeId()
+{
+    static_assert(std::is_trivially_copyable_v<T>, "ECS components are copied bytewise");
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "ECS columns use the default allocation alignment");
+
+    static const ComponentTypeId id = RegisterComponentType(sizeof(T));
+    return id;
+}
+
+template <typename... Components>
+ComponentMask MakeComponentMask()
+{
+    return ((ComponentMask{ 1 } << GetComponentTypeId<Components>()) | ... | ComponentMask{ 0 });
+}
+
+class Archetype
+{
+public:
+    explicit Archetype(ComponentMask mask);
+
+    ComponentMask GetMask() const;
+    std::size_t GetSize() const;
+
+    bool Has(ComponentTypeId type) const;
+
+    // A típus oszlopának eleje; a típusnak az archetípusban kell lennie
+    std::byte* GetColumn(ComponentTypeId type);
+
+    template <typename T>
+    T* GetColumn()
+    {
+        return reinterpret_cast<T*>(GetColumn(GetComponentTypeId<T>()));
+    }
+
+    // a sorok entitásai, az oszlopokkal azonos sorrendben
+    const EntityHandle* GetEntities() const;
+
+    // Új sor a végén, nullázott komponensekkel; visszaadja a sor indexét.
+    // A sorok számának korábbi csúcsáig nem foglal memóriát.
+    std::size_t AddRow(EntityHandle entity);
+
+    // A sor helyére az utolsó kerül; visszaadja az áthelyezett entitás slotját
+    // (InvalidEntityIndex, ha az utolsó sort töröltük)
+    std::uint32_t RemoveRow(std::size_t row);
+
+    // a mindkét archetípusban meglévő komponensek átmásolása
+    void CopyRow(std::size_t row, Archetype& target, std::size_t targetRow) const;
+
+private:
+    struct Column
+    {
+        std::size_t elementSize = 0;
+        std::vector<std::byte> data;
+    };
+
+    ComponentMask mask;
+
+    std::vector<Column> columns;
+    int columnLookup[MaxComponentTypes]; // típus -> oszlop, -1: nincs
+
+    std::vector<EntityHandle> entities;
+};
+
+// Az entitások slot-map-je: a slot a handle indexe, benne a generáció és az
+// entitás helye (archetípus, sor). A létrehozás, törlés és keresés O(1), a
+// szabad slotok láncolt listája magukban a slotokban van, így a csúcsméret
+// elérése után (bemelegedés) nincs több heap foglalás.
+class EcsWorld
+{
+public:
+    EcsWorld() = default;
+
+    EcsWorld(const EcsWorld&) = delete;
+    EcsWorld& operator=(const EcsWorld&) = delete;
+
+    template <typename... Components>
+    EntityHandle Create(const Components&... components)
+    {
+        const EntityHandle entity = AllocateSlot();
+        const std::uint32_t archetypeIndex = GetOrCreateArchetype(MakeComponentMask<Components...>());
+
+        Archetype& archetype = *archetypes[archetypeIndex];
+        const std::size_t row = archetype.AddRow(entity);
+
+        slots[entity.index].archetype = archetypeIndex;
+        slots[entity.index].row = static_cast<std::uint32_t>(row);
+
+        (std::memcpy(archetype.GetColumn<Components>() + row, &components, sizeof(Components)), ...);
+
+        return entity;
+    }
+
+    // Késleltetett törlés: az entitás a FlushDestroyed-ig él, így a futó
+    // bejárások nem látnak lyukat. Többszöri hívás és halott handle is rendben.
+    void Destroy(EntityHandle entity);
+
+    // A képkocka végén: végrehajtja a sorban álló törléseket
+    void FlushDestroyed();
+
+    bool IsAlive(EntityHandle entity) const;
+
+    // nullptr, ha az entitás nem él, vagy nincs ilyen komponense
+    template <typename T>
+    T* Get(EntityHandle entity)
+    {
+        if (!IsAlive(entity))
+            return nullptr;
+
+        const EntitySlot& slot = slots[entity.index];
+        Archetype& archetype = *archetypes[slot.archetype];
+
+        if (!archetype.Has(GetComponentTypeId<T>()))
+            return nullptr;
+
+        return archetype.GetColumn<T>() + slot.row;
+    }
+
+    template <typename T>
+    bool Has(EntityHandle entity) const
+    {
+        return IsAlive(entity) && archetypes[slots[entity.index].archetype]->Has(GetComponentTypeId<T>());
+    }
+
+    // Ha már van ilyen komponense, csak felülírja; különben archetípust vált
+    template <typename T>
+    void Add(EntityHandle entity, const T& component)
+    {
+        if (!IsAlive(entity))
+            return;
+
+        if (!Has<T>(entity))
+        {
+            MoveEntity(entity.index, archetypes[slots[entity.index].archetype]->GetMask() | MakeComponentMask<T>());
+        }
+
+        std::memcpy(Get<T>(entity), &component, sizeof(T));
+    }
+
+    template <typename T>
+    void Remove(EntityHandle entity)
+    {
+        if (Has<T>(entity))
+        {
+            MoveEntity(entity.index, archetypes[slots[entity.index].archetype]->GetMask() & ~MakeComponentMask<T>());
+        }
+    }
+
+    // function(Components&...) minden entitásra, amelynek megvan az összes kért komponense
+    template <typename... Components, typename Function>
+    void ForEach(Function&& function)
+    {
+        ForEachChunk<Components...>([&](std::size_t count, Components*... columns)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                function(columns[i]...);
+            }
+        });
+    }
+
+    // function(count, Components*...) archetípusonként egyszer, az oszlopok elejével.
+    // Ez a szoros (vektorizálható) ciklusok és a munkaszálas feldarabolás alapja.
+    template <typename... Components, typename Function>
+    void ForEachChunk(Function&& function)
+    {
+        const ComponentMask required = MakeComponentMask<Components...>();
+
+        for (const std::unique_ptr<Archetype>& archetype : archetypes)
+        {
+            if ((archetype->GetMask() & required) != required || archetype->GetSize() == 0)
+                continue;
+
+            function(archetype->GetSize(), archetype->GetColumn<Components>()...);
+        }
+    }
+
+    // Mint a ForEach, de a függvény az entitás handle-jét is megkapja (pl. törléshez):
+    // function(EntityHandle, Components&...)
+    template <typename... Components, typename Function>
+    void ForEachEntity(Function&& function)
+    {
+        const ComponentMask required = MakeComponentMask<Components...>();
+
+        for (const std::unique_ptr<Archetype>& archetype : archetypes)
+        {
+            if ((archetype->GetMask() & required) != required || archetype->GetSize() == 0)
+                continue;
+
+            const EntityHandle* entities = archetype->GetEntities();
+            const std::size_t count = archetype->GetSize();
+
+            auto Visit = [&](Components*... columns)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    function(entities[i], columns[i]...);
+                }
+            };
+
+            Visit(archetype->GetColumn<Components>()...);
+        }
+    }
+
+    std::size_t GetEntityCount() const;
+    std::size_t GetArchetypeCount() const;
+    std::size_t GetPendingDestroyCount() const;
+
+private:
+    struct EntitySlot
+    {
+        std::uint32_t archetype = InvalidArchetype; // szabad slotnál InvalidArchetype
+        std::uint32_t row = 0;                      // szabad slotnál a következő szabad slot
+        std::uint32_t generation = 0;
+    };
+
+    static constexpr std::uint32_t InvalidArchetype = ~std::uint32_t{ 0 };
+
+    EntityHandle AllocateSlot();
+    void DestroyImmediate(EntityHandle entity);
+
+    std::uint32_t GetOrCreateArchetype(ComponentMask mask);
+
+    // Az entitás az új maszkú archetípusba kerül, a közös komponensek megmaradnak
+    void MoveEntity(std::uint32_t index, ComponentMask mask);
+
+private:
+    // az archetípusok címe stabil, az új archetípus nem mozgatja a régieket
+    std::vector<std::unique_ptr<Archetype>> archetypes;
+    std::unordered_map<ComponentMask, std::uint32_t> archetypeLookup;
+
+    std::vector<EntitySlot> slots;
+    std::uint32_t freeSlot = InvalidEntityIndex; // a szabad lista feje
+
+    std::vector<EntityHandle> pendingDestroys;
+
+    std::size_t entityCount = 0;
+};
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "EcsBenchmark.h"
+
+#ifdef ENGINE_BENCHMARKS
+
+#include "Components.h"
+#include "Ecs.h"
+#include "Entity.h"
+
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t BenchmarkEntityCount = 100000;
+    constexpr int BenchmarkIterationCount = 20;
+
+    constexpr float StepDeltaTime = 1.0f / 60.0f;
+    constexpr float InterpolationAlpha = 0.5f;
+
+    struct BenchmarkResult
+    {
+        double seconds = 0.0;
+        std::uint64_t checksum = 0;
+    };
+
+    // sorrendfüggetlen ellenőrzőösszeg: az ECS más sorrendben járja be az entitásokat
+    void Accumulate(std::uint64_t& checksum, float value)
+    {
+        checksum += std::bit_cast<std::uint32_t>(value);
+    }
+
+    template <typename Work>
+    BenchmarkResult Measure(Work&& work)
+    {
+        BenchmarkResult result;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int iteration = 0; iteration < BenchmarkIterationCount; ++iteration)
+        {
+            result.checksum += work();
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        result.seconds = std::chrono::duration<double>(end - start).count();
+
+        return result;
+    }
+
+    void Report(const char* name, const BenchmarkResult& pointers, const BenchmarkResult& ecs)
+    {
+        const double entities = static_cast<double>(BenchmarkEntityCount) * BenchmarkIterationCount;
+
+        std::cout
+            << "  " << name << ": "
+            << entities / pointers.seconds / 1.0e6 << " -> "
+            << entities / ecs.seconds / 1.0e6 << " Mentity/s, x"
+            << pointers.seconds / ecs.seconds
+            << (pointers.checksum == ecs.checksum ? "" : "  MISMATCH")
+            << "\n";
+    }
+}
+
+void RunEcsBenchmark()
+{
+    std::mt19937 random(2024);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    // a régi elrendezés: egyenként foglalt entitások, a rendszerek pointereken át érik el
+    std::vector<std::unique_ptr<Entity>> storage;
+    std::vector<Entity*> entities;
+    storage.reserve(BenchmarkEntityCount);
+    entities.reserve(BenchmarkEntityCount);
+
+    EcsWorld world;
+
+    for (std::size_t i = 0; i < BenchmarkEntityCount; ++i)
+    {
+        Transform transform;
+        transform.position = glm::vec3(position(random), 1.0f, position(random));
+        transform.rotationDegrees.y = unit(random) * 360.0f;
+
+        Renderable renderable;
+        renderable.color = glm::vec3(unit(random), unit(random), unit(random));
+
+        // minden második entitás ütközik (barikád), a többi csak látszik
+        CollisionShape collision;
+        if (i % 2 == 0)
+        {
+            collision.type = CollisionShape::Type::AABB;
+            collision.halfExtents = glm::vec3(0.5f);
+        }
+
+        std::unique_ptr<Entity> entity = std::make_unique<Entity>();
+        entity->transform = transform;
+        entity->previousTransform = transform;
+        entity->color = renderable.color;
+        entity->collision = collision;
+
+        entities.push_back(entity.get());
+        storage.push_back(std::move(entity));
+
+        if (collision.type != CollisionShape::Type::None)
+        {
+            world.Create(transform, PreviousTransform{ transform }, renderable, collision);
+        }
+        else
+        {
+            world.Create(transform, PreviousTransform{ transform }, renderable);
+        }
+    }
+
+    std::cout << "ECS benchmark (" << BenchmarkEntityCount << " entities, " << world.GetArchetypeCount() << " archetypes)\n";
+
+    // ---- Simulation step ----
+    BenchmarkResult simulationPointers = Measure([&]
+    {
+        std::uint64_t checksum = 0;
+
+        for (Entity* entity : entities)
+        {
+            entity->previousTransform = entity->transform;
+            entity->transform.rotationDegrees.y += 30.0f * StepDeltaTime;
+
+            Accumulate(checksum, entity->transform.rotationDegrees.y);
+        }
+
+        return checksum;
+    });
+
+    BenchmarkResult simulationEcs = Measure([&]
+    {
+        std::uint64_t checksum = 0;
+
+        world.ForEach<PreviousTransform, Transform>([&](PreviousTransform& previous, Transform& transform)
+        {
+            previous.transform = transform;
+            transform.rotationDegrees.y += 30.0f * StepDeltaTime;
+
+            Accumulate(checksum, transform.rotationDegrees.y);
+        });
+
+        return checksum;
+    });
+
+    Report("simulation step  ", simulationPointers, simulationEcs);
+
+    // ---- Render extraction ----
+    std::vector<glm::mat4> models(BenchmarkEntityCount);
+
+    BenchmarkResult renderPointers = Measure([&]
+    {
+        std::uint64_t checksum = 0;
+        std::size_t index = 0;
+
+        for (const Entity* entity : entities)
+        {
+            glm::mat4& model = models[index++];
+            model = InterpolateTransform(entity->previousTransform, entity->transform, InterpolationAlpha).GetModelMatrix();
+
+            Accumulate(checksum, model[3].x + entity->color.r);
+        }
+
+        return checksum;
+    });
+
+    BenchmarkResult renderEcs = Measure([&]
+    {
+        std::uint64_t checksum = 0;
+        std::size_t index = 0;
+
+        world.ForEach<PreviousTransform, Transform, Renderable>([&](const PreviousTransform& previous, const Transform& transform, const Renderable& renderable)
+        {
+            glm::mat4& model = models[index++];
+            model = InterpolateTransform(previous.transform, transform, InterpolationAlpha).GetModelMatrix();
+
+            Accumulate(checksum, model[3].x + renderable.color.r);
+        });
+
+        return checksum;
+    });
+
+    Report("render extraction", renderPointers, renderEcs);
+
+    // ---- Collision bounds ----
+    // a régi elrendezés minden entitást megnéz, az ECS csak az ütköző archetípust
+    BenchmarkResult boundsPointers = Measure([&]
+    {
+        std::uint64_t checksum = 0;
+
+        for (const Entity* entity : entities)
+        {
+            if (entity->collision.type != CollisionShape::Type::AABB)
+                continue;
+
+            const glm::vec3 center = entity->transform.position + entity->collision.localOffset;
+            Accumulate(checksum, center.x - entity->collision.halfExtents.x);
+            Accumulate(checksum, center.z + entity->collision.halfExtents.z);
+        }
+
+        return checksum;
+    });
+
+    BenchmarkResult boundsEcs = Measure([&]
+    {
+        std::uint64_t checksum = 0;
+
+        world.ForEachChunk<Transform, CollisionShape>([&](std::size_t count, const Transform* transforms, const CollisionShape* collisions)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const glm::vec3 center = transforms[i].position + collisions[i].localOffset;
+                Accumulate(checksum, center.x - collisions[i].halfExtents.x);
+                Accumulate(checksum, center.z + collisions[i].halfExtents.z);
+            }
+        });
+
+        return checksum;
+    });
+
+    Report("collision bounds ", boundsPointers, boundsEcs);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+#ifdef ENGINE_BENCHMARKS
+
+// Bejárási áteresztőképesség 100k entitáson: a régi elrendezés (egyenként
+// foglalt Entity-k pointer vektorból) vs. az ECS archetípus oszlopai.
+// A munkák a játék ciklusát követik: szimulációs lépés, render kinyerés,
+// ütközési dobozok. Ellenőrzi, hogy a két oldal eredménye egyezik.
+void RunEcsBenchmark();
+
+#endif
\ No newline at end of file
@@ -2,15 +2,36 @@
 
 #include "Transform.h"
 #include "CollisionShape.h"
+#include "AABB.h"
+#include "OBB.h"
+
+enum class Mobility
+{
+    Static,  // fal, talaj: sosem mozog
+    Dynamic
+};
 
 struct Entity
 {
     Transform transform;
 
+    // az előző szimulációs lépés állapota, a renderelés ez és a transform között interpolál
+    Transform previousTransform;
+
+    Mobility mobility = Mobility::Dynamic;
+
     // Collision
     CollisionShape collision;
 
     // Render
     glm::vec3 color = glm::vec3(1.0f);
     bool useVertexColor = false;
+
+    // GetWorldAABB gyorsítótára
+    mutable AABB cachedWorldAABB{};
+    mutable bool worldAABBDirty = true;
+
+    // GetWorldOBB gyorsítótára (csak OBB alakzatnál használt)
+    mutable OBB cachedWorldOBB{};
+    mutable bool worldOBBDirty = true;
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "FixedTimestep.h"
+
+#include <algorithm>
+
+FixedTimestep::FixedTimestep(double tickRate, int maxStepsPerFrame)
+    : tickRate(tickRate),
+    stepDeltaTime(1.0 / tickRate),
+    maxStepsPerFrame(std::max(1, maxStepsPerFrame))
+{
+}
+
+int FixedTimestep::Advance(double frameDeltaTime)
+{
+    accumulator += std::max(0.0, frameDeltaTime);
+
+    int steps = 0;
+
+    while (accumulator >= stepDeltaTime && steps < maxStepsPerFrame)
+    {
+        accumulator -= stepDeltaTime;
+        ++steps;
+    }
+
+    // nem tudjuk utolérni: a lemaradást eldobjuk, a játék lelassul
+    if (accumulator >= stepDeltaTime)
+        accumulator = 0.0;
+
+    return steps;
+}
+
+void FixedTimestep::SetTickRate(double newTickRate)
+{
+    tickRate = newTickRate;
+    stepDeltaTime = 1.0 / newTickRate;
+    accumulator = std::min(accumulator, stepDeltaTime);
+}
+
+double FixedTimestep::GetTickRate() const
+{
+    return tickRate;
+}
+
+void FixedTimestep::SetMaxStepsPerFrame(int maxSteps)
+{
+    maxStepsPerFrame = std::max(1, maxSteps);
+}
+
+int FixedTimestep::GetMaxStepsPerFrame() const
+{
+    return maxStepsPerFrame;
+}
+
+float FixedTimestep::GetStepDeltaTime() const
+{
+    return static_cast<float>(stepDeltaTime);
+}
+
+float FixedTimestep::GetInterpolationAlpha() const
+{
+    return static_cast<float>(accumulator / stepDeltaTime);
+}
\ No newline at end of file
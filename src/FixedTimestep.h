@@ -0,0 +1,32 @@
+#pragma once
+
+// Fix lépésközű szimuláció akkumulátorral. A képkocka idejét gyűjti, és
+// megmondja, hány szimulációs lépést kell futtatni. Egy akadás után legfeljebb
+// maxStepsPerFrame lépést pótol, a maradékot eldobja (különben a lemaradás nőne).
+class FixedTimestep
+{
+public:
+    explicit FixedTimestep(double tickRate = 60.0, int maxStepsPerFrame = 5);
+
+    // Hozzáadja a képkocka idejét, visszaadja a futtatandó lépések számát
+    int Advance(double frameDeltaTime);
+
+    void SetTickRate(double tickRate);
+    double GetTickRate() const;
+
+    void SetMaxStepsPerFrame(int maxSteps);
+    int GetMaxStepsPerFrame() const;
+
+    // egy lépés hossza másodpercben
+    float GetStepDeltaTime() const;
+
+    // [0, 1): mennyit haladt az idő az utolsó lépés után, a rendereléshez
+    float GetInterpolationAlpha() const;
+
+private:
+    double tickRate;
+    double stepDeltaTime;
+    int maxStepsPerFrame;
+
+    double accumulator = 0.0;
+};
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+#ifdef ENGINE_DEBUG
+#include <iostream>
+#endif
+
+namespace
+{
+    // a buffer eleje cache sorra igazított
+    constexpr std::size_t BufferAlignment = 64;
+}
+
+// ---- LinearArena ----
+
+LinearArena::LinearArena(std::size_t capacity)
+    : capacity(capacity)
+{
+    buffer = static_cast<std::byte*>(::operator new(capacity, std::align_val_t{ BufferAlignment }));
+}
+
+LinearArena::~LinearArena()
+{
+    ReleaseOverflow(0);
+    ::operator delete(buffer, std::align_val_t{ BufferAlignment });
+}
+
+void* LinearArena::Allocate(std::size_t size, std::size_t alignment)
+{
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buffer);
+    const std::uintptr_t aligned = (base + offset + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    const std::size_t alignedOffset = static_cast<std::size_t>(aligned - base);
+
+    if (alignedOffset + size > capacity)
+        return AllocateOverflow(size, alignment);
+
+    offset = alignedOffset + size;
+
+#ifdef ENGINE_DEBUG
+    highWaterMark = std::max(highWaterMark, offset + overflowBytes);
+#endif
+
+    return buffer + alignedOffset;
+}
+
+void* LinearArena::AllocateOverflow(std::size_t size, std::size_t alignment)
+{
+    alignment = std::max(alignment, alignof(std::max_align_t));
+
+    void* data = ::operator new(std::max<std::size_t>(size, 1), std::align_val_t{ alignment });
+    overflowBlocks.push_back({ data, size, alignment });
+
+#ifdef ENGINE_DEBUG
+    overflowBytes += size;
+    highWaterMark = std::max(highWaterMark, offset + overflowBytes);
+
+    if (!overflowReported)
+    {
+        overflowReported = true;
+        std::cerr << "Frame arena is full (" << capacity << " bytes), falling back to the heap\n";
+    }
+#endif
+
+    return data;
+}
+
+void LinearArena::ReleaseOverflow(std::size_t keepCount)
+{
+    while (overflowBlocks.size() > keepCount)
+    {
+        const OverflowBlock& block = overflowBlocks.back();
+
+#ifdef ENGINE_DEBUG
+        overflowBytes -= block.size;
+#endif
+
+        ::operator delete(block.data, std::align_val_t{ block.alignment });
+        overflowBlocks.pop_back();
+    }
+}
+
+ArenaMarker LinearArena::GetMarker() const
+{
+    return { offset, overflowBlocks.size() };
+}
+
+void LinearArena::Rewind(const ArenaMarker& marker)
+{
+    offset = marker.offset;
+    ReleaseOverflow(marker.overflowBlockCount);
+}
+
+void LinearArena::Reset()
+{
+    Rewind({});
+}
+
+std::size_t LinearArena::GetCapacity() const
+{
+    return capacity;
+}
+
+std::size_t LinearArena::GetUsage() const
+{
+    return offset;
+}
+
+#ifdef ENGINE_DEBUG
+
+std::size_t LinearArena::GetHighWaterMark() const
+{
+    return highWaterMark;
+}
+
+#endif
+
+// ---- FrameArena ----
+
+FrameArena::FrameArena(JobSystem& jobs, std::size_t bytesPerThread)
+    : jobs(jobs)
+{
+    for (int i = 0; i < jobs.GetThreadCount(); ++i)
+    {
+        arenas.push_back(std::make_unique<LinearArena>(bytesPerThread));
+    }
+}
+
+void FrameArena::BeginFrame()
+{
+    for (const std::unique_ptr<LinearArena>& arena : arenas)
+    {
+        arena->Reset();
+    }
+}
+
+LinearArena& FrameArena::GetThreadArena()
+{
+    return *arenas[jobs.GetCurrentThreadIndex()];
+}
+
+LinearArena& FrameArena::GetArena(int thread)
+{
+    return *arenas[thread];
+}
+
+std::size_t FrameArena::GetBytesPerThread() const
+{
+    return arenas.front()->GetCapacity();
+}
+
+#ifdef ENGINE_DEBUG
+
+std::size_t FrameArena::GetHighWaterMark() const
+{
+    std::size_t highWaterMark = 0;
+
+    for (const std::unique_ptr<LinearArena>& arena : arenas)
+    {
+        highWaterMark = std::max(highWaterMark, arena->GetHighWaterMark());
+    }
+
+    return highWaterMark;
+}
+
+#endif
\ No newline at end of file
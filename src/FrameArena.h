@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "JobSystem.h"
+
+// Egy ArenaMarker az aréna addigi állapota, a Rewind ide tér vissza
+struct ArenaMarker
+{
+    std::size_t offset = 0;
+    std::size_t overflowBlockCount = 0;
+};
+
+// Lineáris (bump) aréna rögzített bufferrel. A foglalás egy igazítás és egy
+// összeadás, felszabadítás nincs: a Reset vagy a Rewind egyszerre adja vissza
+// a memóriát. Ha a buffer betelik, a foglalás a heapre esik vissza (ezeket a
+// blokkokat is a Reset/Rewind engedi el), debug buildben ezt egyszer jelzi.
+//
+// Egy arénát egyszerre csak egy szál használhat (ld. FrameArena).
+class LinearArena
+{
+public:
+    explicit LinearArena(std::size_t capacity);
+    ~LinearArena();
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    // alignment: kettő hatványa; sosem ad nullptr-t
+    void* Allocate(std::size_t size, std::size_t alignment);
+
+    // Inicializálatlan tömb; a destruktor nem fut le, ezért csak egyszerű típusokra
+    template <typename T>
+    T* AllocateArray(std::size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "arena memory is released without destructors");
+        return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    ArenaMarker GetMarker() const;
+    void Rewind(const ArenaMarker& marker);
+    void Reset();
+
+    std::size_t GetCapacity() const;
+    std::size_t GetUsage() const;
+
+#ifdef ENGINE_DEBUG
+    // a legnagyobb egyidejű foglalás (a heapre esett részt is beleértve)
+    std::size_t GetHighWaterMark() const;
+#endif
+
+private:
+    struct OverflowBlock
+    {
+        void* data;
+        std::size_t size;
+        std::size_t alignment;
+    };
+
+    void* AllocateOverflow(std::size_t size, std::size_t alignment);
+    void ReleaseOverflow(std::size_t keepCount);
+
+private:
+    std::byte* buffer = nullptr;
+    std::size_t capacity = 0;
+    std::size_t offset = 0;
+
+    std::vector<OverflowBlock> overflowBlocks;
+
+#ifdef ENGINE_DEBUG
+    std::size_t overflowBytes = 0;
+    std::size_t highWaterMark = 0;
+    bool overflowReported = false;
+#endif
+};
+
+// A hatókör végén az arénát a létrehozáskori állapotára tekeri vissza:
+// ideiglenes (scratch) memória egy függvényen belül
+class ScratchScope
+{
+public:
+    explicit ScratchScope(LinearArena& arena)
+        : arena(arena),
+        marker(arena.GetMarker())
+    {
+    }
+
+    ~ScratchScope()
+    {
+        arena.Rewind(marker);
+    }
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+private:
+    LinearArena& arena;
+    ArenaMarker marker;
+};
+
+// STL allocator az arénára. A deallocate üres, a memória az aréna
+// visszaállításakor szabadul fel, ezért a konténer nem élheti túl azt.
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    // hozzárendeléskor és cserekor az aréna a tartalommal együtt megy
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit ArenaAllocator(LinearArena& arena)
+        : arena(&arena)
+    {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other)
+        : arena(other.GetArena())
+    {
+    }
+
+    T* allocate(std::size_t count)
+    {
+        return static_cast<T*>(arena->Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t)
+    {
+    }
+
+    LinearArena* GetArena() const
+    {
+        return arena;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const
+    {
+        return arena == other.GetArena();
+    }
+
+private:
+    LinearArena* arena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+// Képkockánkénti arénák, a job rendszer szálanként egyet: a szál a sajátjából
+// foglal, így nincs szinkronizálás. A BeginFrame mindet üríti, ezért a
+// foglalások csak a képkocka végéig érvényesek. A BeginFrame-et a fő szál
+// hívja a képkocka elején, amikor jobok nem futnak.
+class FrameArena
+{
+public:
+    FrameArena(JobSystem& jobs, std::size_t bytesPerThread);
+
+    void BeginFrame();
+
+    // a hívó szál arénája
+    LinearArena& GetThreadArena();
+
+    // egy adott szál arénája, pl. egy konténer hozzárendeléséhez (foglalni
+    // belőle csak az a szál foglalhat)
+    LinearArena& GetArena(int thread);
+
+    std::size_t GetBytesPerThread() const;
+
+#ifdef ENGINE_DEBUG
+    // a szálankénti csúcshasználat legnagyobbika
+    std::size_t GetHighWaterMark() const;
+#endif
+
+private:
+    JobSystem& jobs;
+
+    std::vector<std::unique_ptr<LinearArena>> arenas;
+};
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "FrustumCulling.h"
+#include "Simd.h"
+
+#include <bit>
+#include <cmath>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+Frustum ExtractFrustum(const glm::mat4& viewProjection)
+{
+    // glm oszlopfolytonos: az i. sor (m[0][i], m[1][i], m[2][i], m[3][i])
+    auto Row = [&](int i)
+    {
+        return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+    };
+
+    const glm::vec4 row0 = Row(0);
+    const glm::vec4 row1 = Row(1);
+    const glm::vec4 row2 = Row(2);
+    const glm::vec4 row3 = Row(3);
+
+    Frustum frustum;
+    frustum.planes[0] = row3 + row0; // bal
+    frustum.planes[1] = row3 - row0; // jobb
+    frustum.planes[2] = row3 + row1; // alsó
+    frustum.planes[3] = row3 - row1; // felső
+    frustum.planes[4] = row3 + row2; // közeli (OpenGL: -1..1 mélység)
+    frustum.planes[5] = row3 - row2; // távoli
+
+    for (glm::vec4& plane : frustum.planes)
+    {
+        plane /= glm::length(glm::vec3(plane));
+    }
+
+    return frustum;
+}
+
+bool IsAABBInFrustum(const Frustum& frustum, const AABB& box)
+{
+    const glm::vec3 center = (box.min + box.max) * 0.5f;
+    const glm::vec3 extents = (box.max - box.min) * 0.5f;
+
+    // a doboz a sík mögött van, ha a sík felé legközelebbi csúcsa is mögötte van
+    for (const glm::vec4& plane : frustum.planes)
+    {
+        const glm::vec3 normal(plane);
+
+        if (glm::dot(normal, center) + plane.w + glm::dot(glm::abs(normal), extents) < 0.0f)
+            return false;
+    }
+
+    return true;
+}
+
+AABB ComputeUnitCubeBounds(const glm::mat4& model)
+{
+    const glm::vec3 center(model[3]);
+    const glm::vec3 extents =
+        (glm::abs(glm::vec3(model[0])) + glm::abs(glm::vec3(model[1])) + glm::abs(glm::vec3(model[2]))) * 0.5f;
+
+    return { center - extents, center + extents };
+}
+
+namespace
+{
+    std::size_t CullScalar(const Frustum& frustum, const AABBSoA& boxes, std::size_t first, std::vector<std::uint32_t>& outVisible)
+    {
+        std::size_t visible = 0;
+
+        for (std::size_t i = first; i < boxes.Size(); ++i)
+        {
+            if (!IsAABBInFrustum(frustum, boxes.Get(i)))
+                continue;
+
+            outVisible.push_back(static_cast<std::uint32_t>(i));
+            ++visible;
+        }
+
+        return visible;
+    }
+
+    // a maszk beállított bitjeinek indexét írja ki növekvő sorrendben
+    void AppendVisible(std::uint32_t mask, std::size_t first, std::vector<std::uint32_t>& outVisible)
+    {
+        while (mask != 0)
+        {
+            outVisible.push_back(static_cast<std::uint32_t>(first + std::countr_zero(mask)));
+            mask &= mask - 1;
+        }
+    }
+
+#ifdef ZS_SIMD_X86
+
+    ZS_TARGET_SSE2 std::size_t CullSSE(const Frustum& frustum, const AABBSoA& boxes, std::vector<std::uint32_t>& outVisible)
+    {
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 zero = _mm_setzero_ps();
+
+        std::size_t visible = 0;
+        std::size_t i = 0;
+
+        for (; i + 4 <= boxes.Size(); i += 4)
+        {
+            const __m128 mnx = _mm_loadu_ps(&boxes.minX[i]);
+            const __m128 mny = _mm_loadu_ps(&boxes.minY[i]);
+            const __m128 mnz = _mm_loadu_ps(&boxes.minZ[i]);
+            const __m128 mxx = _mm_loadu_ps(&boxes.maxX[i]);
+            const __m128 mxy = _mm_loadu_ps(&boxes.maxY[i]);
+            const __m128 mxz = _mm_loadu_ps(&boxes.maxZ[i]);
+
+            const __m128 cx = _mm_mul_ps(_mm_add_ps(mnx, mxx), half);
+            const __m128 cy = _mm_mul_ps(_mm_add_ps(mny, mxy), half);
+            const __m128 cz = _mm_mul_ps(_mm_add_ps(mnz, mxz), half);
+            const __m128 ex = _mm_mul_ps(_mm_sub_ps(mxx, mnx), half);
+            const __m128 ey = _mm_mul_ps(_mm_sub_ps(mxy, mny), half);
+            const __m128 ez = _mm_mul_ps(_mm_sub_ps(mxz, mnz), half);
+
+            __m128 outside = _mm_setzero_ps();
+
+            for (const glm::vec4& plane : frustum.planes)
+            {
+                __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(plane.x)), _mm_mul_ps(cy, _mm_set1_ps(plane.y))),
+                    _mm_add_ps(_mm_mul_ps(cz, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w)));
+
+                __m128 radius = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(std::abs(plane.x))), _mm_mul_ps(ey, _mm_set1_ps(std::abs(plane.y)))),
+                    _mm_mul_ps(ez, _mm_set1_ps(std::abs(plane.z))));
+
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+            }
+
+            const std::uint32_t mask = ~static_cast<std::uint32_t>(_mm_movemask_ps(outside)) & 0xFu;
+
+            AppendVisible(mask, i, outVisible);
+            visible += static_cast<std::size_t>(std::popcount(mask));
+        }
+
+        return visible + CullScalar(frustum, boxes, i, outVisible);
+    }
+
+    ZS_TARGET_AVX2 std::size_t CullAVX2(const Frustum& frustum, const AABBSoA& boxes, std::vector<std::uint32_t>& outVisible)
+    {
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 zero = _mm256_setzero_ps();
+
+        std::size_t visible = 0;
+        std::size_t i = 0;
+
+        for (; i + 8 <= boxes.Size(); i += 8)
+        {
+            const __m256 mnx = _mm256_loadu_ps(&boxes.minX[i]);
+            const __m256 mny = _mm256_loadu_ps(&boxes.minY[i]);
+            const __m256 mnz = _mm256_loadu_ps(&boxes.minZ[i]);
+            const __m256 mxx = _mm256_loadu_ps(&boxes.maxX[i]);
+            const __m256 mxy = _mm256_loadu_ps(&boxes.maxY[i]);
+            const __m256 mxz = _mm256_loadu_ps(&boxes.maxZ[i]);
+
+            const __m256 cx = _mm256_mul_ps(_mm256_add_ps(mnx, mxx), half);
+            const __m256 cy = _mm256_mul_ps(_mm256_add_ps(mny, mxy), half);
+            const __m256 cz = _mm256_mul_ps(_mm256_add_ps(mnz, mxz), half);
+            const __m256 ex = _mm256_mul_ps(_mm256_sub_ps(mxx, mnx), half);
+            const __m256 ey = _mm256_mul_ps(_mm256_sub_ps(mxy, mny), half);
+            const __m256 ez = _mm256_mul_ps(_mm256_sub_ps(mxz, mnz), half);
+
+            __m256 outside = _mm256_setzero_ps();
+
+            for (const glm::vec4& plane : frustum.planes)
+            {
+                __m256 distance = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(cx, _mm256_set1_ps(plane.x)), _mm256_mul_ps(cy, _mm256_set1_ps(plane.y))),
+                    _mm256_add_ps(_mm256_mul_ps(cz, _mm256_set1_ps(plane.z)), _mm256_set1_ps(plane.w)));
+
+                __m256 radius = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(ex, _mm256_set1_ps(std::abs(plane.x))), _mm256_mul_ps(ey, _mm256_set1_ps(std::abs(plane.y)))),
+                    _mm256_mul_ps(ez, _mm256_set1_ps(std::abs(plane.z))));
+
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_LT_OQ));
+            }
+
+            const std::uint32_t mask = ~static_cast<std::uint32_t>(_mm256_movemask_ps(outside)) & 0xFFu;
+
+            AppendVisible(mask, i, outVisible);
+            visible += static_cast<std::size_t>(std::popcount(mask));
+        }
+
+        return visible + CullScalar(frustum, boxes, i, outVisible);
+    }
+
+#endif
+}
+
+std::size_t CullAABBs(const Frustum& frustum, const AABBSoA& boxes, std::vector<std::uint32_t>& outVisible)
+{
+    outVisible.clear();
+
+    switch (GetSimdLevel())
+    {
+#ifdef ZS_SIMD_X86
+    case SimdLevel::AVX2:
+        return CullAVX2(frustum, boxes, outVisible);
+    case SimdLevel::SSE:
+        return CullSSE(frustum, boxes, outVisible);
+#endif
+    default:
+        return CullScalar(frustum, boxes, 0, outVisible);
+    }
+}
\ No newline at end of file
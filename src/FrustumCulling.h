@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+#include "AABB.h"
+#include "CollisionBatch.h"
+
+// A hat sík (bal, jobb, alsó, felső, közeli, távoli) befelé mutató normállal,
+// normalizálva: dot(plane.xyz, p) + plane.w a p pont előjeles távolsága.
+struct Frustum
+{
+    glm::vec4 planes[6];
+};
+
+// Gribb-Hartmann: a síkok a projection * view mátrix soraiból
+Frustum ExtractFrustum(const glm::mat4& viewProjection);
+
+// A látható dobozok indexét tömören az outVisible végére írja (előtte kiüríti),
+// és visszaadja a számukat. A SIMD szintet a GetSimdLevel adja.
+std::size_t CullAABBs(const Frustum& frustum, const AABBSoA& boxes, std::vector<std::uint32_t>& outVisible);
+
+// Egy doboz teszt a kis darabszámú esetekhez (pl. debug rajzolás)
+bool IsAABBInFrustum(const Frustum& frustum, const AABB& box);
+
+// Az egységkocka mesh ([-0.5, 0.5]^3) befoglaló doboza a model mátrix után
+AABB ComputeUnitCubeBounds(const glm::mat4& model);
\ No newline at end of file
@@ -0,0 +1,190 @@
+#include "GpuDrivenRenderer.h"
+#include "MeshFile.h"
+
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <glad/glad.h>
+
+GpuDrivenRenderer::GpuDrivenRenderer(StreamBuffer& stream)
+    : stream(stream)
+{
+}
+
+GpuDrivenRenderer::~GpuDrivenRenderer()
+{
+    glDeleteVertexArrays(1, &vao);
+    glDeleteBuffers(1, &vertexBuffer);
+    glDeleteBuffers(1, &indexBuffer);
+}
+
+void GpuDrivenRenderer::BeginMeshRange(std::uint32_t meshId, std::size_t indexCount)
+{
+    if (meshId >= meshRanges.size())
+        meshRanges.resize(meshId + 1);
+
+    MeshRange& range = meshRanges[meshId];
+    range.firstIndex = static_cast<std::uint32_t>(indices.size());
+    range.indexCount = static_cast<std::uint32_t>(indexCount);
+    range.baseVertex = static_cast<std::int32_t>(vertices.size());
+}
+
+void GpuDrivenRenderer::AddMesh(std::uint32_t meshId, const MeshData& data)
+{
+    BeginMeshRange(meshId, data.indices.size());
+
+    // az indexek a mesh saját vertexeire mutatnak, az eltolást a baseVertex adja
+    vertices.insert(vertices.end(), data.vertices.begin(), data.vertices.end());
+    indices.insert(indices.end(), data.indices.begin(), data.indices.end());
+
+    geometryDirty = true;
+}
+
+bool GpuDrivenRenderer::AddMesh(std::uint32_t meshId, const MeshFile& file)
+{
+    const MeshFileHeader& header = file.GetHeader();
+
+    bool matchesMeshVertex = header.vertexStride == sizeof(MeshVertex) && header.attributeCount == std::size(MeshVertexAttributes);
+
+    for (std::uint32_t i = 0; matchesMeshVertex && i < header.attributeCount; ++i)
+    {
+        const MeshFileAttribute& attribute = header.attributes[i];
+        const MeshFileAttribute& expected = MeshVertexAttributes[i];
+
+        matchesMeshVertex = attribute.location == expected.location
+            && attribute.componentCount == expected.componentCount
+            && attribute.offset == expected.offset;
+    }
+
+    if (!matchesMeshVertex)
+    {
+        std::cerr << "GPU-driven path needs the position + color vertex layout, mesh " << meshId << " has a different one\n";
+        return false;
+    }
+
+    BeginMeshRange(meshId, file.GetIndexCount());
+
+    // a layout egyezik, így a vertex blob bájtra a MeshVertex tömb
+    const std::size_t firstVertex = vertices.size();
+    vertices.resize(firstVertex + header.vertexCount);
+    std::memcpy(vertices.data() + firstVertex, file.GetVertexData(), file.GetVertexDataSize());
+
+    indices.insert(indices.end(), file.GetIndexData(), file.GetIndexData() + file.GetIndexCount());
+
+    geometryDirty = true;
+    return true;
+}
+
+void GpuDrivenRenderer::BuildGeometryBuffers()
+{
+    if (vao == 0)
+    {
+        glCreateVertexArrays(1, &vao);
+
+        for (const MeshFileAttribute& attribute : MeshVertexAttributes)
+        {
+            glEnableVertexArrayAttrib(vao, attribute.location);
+            glVertexArrayAttribFormat(vao, attribute.location, static_cast<GLint>(attribute.componentCount), GL_FLOAT, GL_FALSE, attribute.offset);
+            glVertexArrayAttribBinding(vao, attribute.location, 0);
+        }
+    }
+
+    // a geometria ritkán változik: immutable bufferek, változáskor újak
+    glDeleteBuffers(1, &vertexBuffer);
+    glDeleteBuffers(1, &indexBuffer);
+
+    glCreateBuffers(1, &vertexBuffer);
+    glCreateBuffers(1, &indexBuffer);
+
+    glNamedBufferStorage(vertexBuffer, static_cast<GLsizeiptr>(vertices.size() * sizeof(MeshVertex)), vertices.data(), 0);
+    glNamedBufferStorage(indexBuffer, static_cast<GLsizeiptr>(indices.size() * sizeof(std::uint32_t)), indices.data(), 0);
+
+    glVertexArrayVertexBuffer(vao, 0, vertexBuffer, 0, sizeof(MeshVertex));
+    glVertexArrayElementBuffer(vao, indexBuffer);
+
+    geometryDirty = false;
+}
+
+StreamAllocation GpuDrivenRenderer::AllocateInstances(std::size_t count)
+{
+    if (geometryDirty || vao == 0)
+        BuildGeometryBuffers();
+
+    commands.clear();
+    drawFirstInstances.clear();
+
+    multiDrawCount = 0;
+    drawCommandCount = 0;
+
+    instances = stream.Allocate(count * sizeof(InstanceData), stream.GetStorageAlignment());
+
+    return instances;
+}
+
+void GpuDrivenRenderer::AddDraw(std::uint32_t meshId, std::uint32_t firstInstance, std::uint32_t count)
+{
+    if (meshId >= meshRanges.size() || meshRanges[meshId].indexCount == 0 || count == 0)
+        return;
+
+    const MeshRange& range = meshRanges[meshId];
+
+    commands.push_back({ range.indexCount, count, range.firstIndex, range.baseVertex, firstInstance });
+    drawFirstInstances.push_back(firstInstance);
+}
+
+void GpuDrivenRenderer::Submit()
+{
+    if (commands.empty() || !instances.IsValid())
+    {
+        commands.clear();
+        drawFirstInstances.clear();
+        return;
+    }
+
+    const std::size_t drawDataSize = drawFirstInstances.size() * sizeof(std::uint32_t);
+    const std::size_t commandsSize = commands.size() * sizeof(DrawElementsIndirectCommand);
+
+    const StreamAllocation drawData = stream.Allocate(drawDataSize, stream.GetStorageAlignment());
+    const StreamAllocation commandData = stream.Allocate(commandsSize, alignof(DrawElementsIndirectCommand));
+
+    if (!drawData.IsValid() || !commandData.IsValid())
+    {
+        commands.clear();
+        drawFirstInstances.clear();
+        return;
+    }
+
+    std::memcpy(drawData.data, drawFirstInstances.data(), drawDataSize);
+    std::memcpy(commandData.data, commands.data(), commandsSize);
+
+    const unsigned int buffer = stream.GetBuffer();
+
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, GpuInstanceBufferBinding, buffer, static_cast<GLintptr>(instances.offset), static_cast<GLsizeiptr>(instances.size));
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, GpuDrawDataBinding, buffer, static_cast<GLintptr>(drawData.offset), static_cast<GLsizeiptr>(drawDataSize));
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer);
+    glBindVertexArray(vao);
+
+    // az indirect paraméter itt a parancsok offsete a kötött bufferben
+    glMultiDrawElementsIndirect(
+        GL_TRIANGLES,
+        GL_UNSIGNED_INT,
+        reinterpret_cast<const void*>(commandData.offset),
+        static_cast<GLsizei>(commands.size()),
+        0);
+
+    ++multiDrawCount;
+    drawCommandCount += static_cast<int>(commands.size());
+
+    commands.clear();
+    drawFirstInstances.clear();
+}
+
+int GpuDrivenRenderer::GetMultiDrawCount() const
+{
+    return multiDrawCount;
+}
+
+int GpuDrivenRenderer::GetDrawCommandCount() const
+{
+    return drawCommandCount;
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "InstancedRenderer.h"
+#include "MeshData.h"
+#include "StreamBuffer.h"
+
+class MeshFile;
+
+// SSBO binding pontok, a GPU-driven vertex shaderrel egyeznie kell
+constexpr unsigned int GpuInstanceBufferBinding = 0;
+constexpr unsigned int GpuDrawDataBinding = 1;
+
+// glMultiDrawElementsIndirect parancs (a GL specifikáció elrendezése)
+struct DrawElementsIndirectCommand
+{
+    std::uint32_t count;
+    std::uint32_t instanceCount;
+    std::uint32_t firstIndex;
+    std::int32_t baseVertex;
+    std::uint32_t baseInstance;
+};
+
+// Minden mesh egy közös vertex és index bufferben, a rajzolások pedig egy
+// indirect parancstömbben. Egy Submit egyetlen glMultiDrawElementsIndirect:
+// a shader a gl_DrawID-vel a draw data SSBO-ból kapja a példányok kezdetét,
+// azon belül a gl_InstanceID-vel az instance SSBO-ból a példány adatát.
+// A példányok, a draw data és a parancsok a stream bufferben vannak.
+class GpuDrivenRenderer
+{
+public:
+    explicit GpuDrivenRenderer(StreamBuffer& stream);
+    ~GpuDrivenRenderer();
+
+    GpuDrivenRenderer(const GpuDrivenRenderer&) = delete;
+    GpuDrivenRenderer& operator=(const GpuDrivenRenderer&) = delete;
+
+    // meshId: a RenderQueue által adott azonosító. A közös buffereket a
+    // következő rajzolás előtt építi újra, ezért induláskor érdemes hívni.
+    void AddMesh(std::uint32_t meshId, const MeshData& data);
+
+    // .zsm-ből ugyanígy; a közös VAO miatt a fájlnak a MeshVertex layoutját
+    // kell használnia, eltérő layoutnál üzenetet ír és false-t ad
+    bool AddMesh(std::uint32_t meshId, const MeshFile& file);
+
+    // Hely a képkocka összes példányának (a RenderQueue rendezett sorrendjében),
+    // a hívó tölti ki. Ez lesz az instance SSBO a következő Submit-okhoz.
+    StreamAllocation AllocateInstances(std::size_t count);
+
+    // Egy parancs a következő Submit-hoz: a mesh count példánya firstInstance-tól
+    void AddDraw(std::uint32_t meshId, std::uint32_t firstInstance, std::uint32_t count);
+
+    // Egy glMultiDrawElementsIndirect az eddig gyűjtött parancsokkal; a shadert a hívó állítja be
+    void Submit();
+
+    // az utolsó AllocateInstances óta
+    int GetMultiDrawCount() const;
+    int GetDrawCommandCount() const;
+
+private:
+    struct MeshRange
+    {
+        std::uint32_t firstIndex = 0;
+        std::uint32_t indexCount = 0;
+        std::int32_t baseVertex = 0;
+    };
+
+    // a meshId tartománya a közös bufferek jelenlegi végétől
+    void BeginMeshRange(std::uint32_t meshId, std::size_t indexCount);
+    void BuildGeometryBuffers();
+
+private:
+    StreamBuffer& stream;
+    std::vector<MeshVertex> vertices;
+    std::vector<std::uint32_t> indices;
+    std::vector<MeshRange> meshRanges; // meshId szerint
+    bool geometryDirty = false;
+
+    unsigned int vao = 0;
+    unsigned int vertexBuffer = 0;
+    unsigned int indexBuffer = 0;
+
+    StreamAllocation instances;
+
+    std::vector<DrawElementsIndirectCommand> commands;
+    std::vector<std::uint32_t> drawFirstInstances; // a draw data SSBO tartalma
+
+    int multiDrawCount = 0;
+    int drawCommandCount = 0;
+};
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "InstancedRenderer.h"
+#include "Mesh.h"
+
+#include <cstddef>
+#include <cstring>
+#include <glad/glad.h>
+
+InstancedRenderer::InstancedRenderer(StreamBuffer& stream)
+    : stream(stream)
+{
+}
+
+void InstancedRenderer::Begin()
+{
+    for (Batch& batch : batches)
+    {
+        batch.instances.clear();
+    }
+}
+
+void InstancedRenderer::Submit(const Mesh& mesh, const glm::mat4& model, const glm::vec3& color, bool useVertexColor)
+{
+    GetBatch(mesh).instances.push_back({ model, glm::vec4(color, useVertexColor ? 1.0f : 0.0f) });
+}
+
+void InstancedRenderer::Flush()
+{
+    drawCallCount = 0;
+    instanceCount = 0;
+
+    for (Batch& batch : batches)
+    {
+        if (batch.instances.empty())
+            continue;
+
+        const StreamAllocation allocation = AllocateInstances(batch.instances.size());
+        if (!allocation.IsValid())
+            continue;
+
+        std::memcpy(allocation.data, batch.instances.data(), allocation.size);
+        DrawBatch(*batch.mesh, allocation, 0, batch.instances.size());
+
+        ++drawCallCount;
+        instanceCount += batch.instances.size();
+    }
+
+    glBindVertexArray(0);
+}
+
+StreamAllocation InstancedRenderer::AllocateInstances(std::size_t count)
+{
+    return stream.Allocate(count * sizeof(InstanceData), stream.GetStorageAlignment());
+}
+
+void InstancedRenderer::DrawBatch(const Mesh& mesh, const StreamAllocation& instances, std::size_t first, std::size_t count)
+{
+    if (count == 0 || !instances.IsValid())
+        return;
+
+    Batch& batch = GetBatch(mesh);
+    ConfigureVertexArray(batch);
+
+    // csak a binding offsete változik, a formátum a VAO-ban marad
+    const GLintptr offset = static_cast<GLintptr>(instances.offset + first * sizeof(InstanceData));
+    glVertexArrayVertexBuffer(mesh.GetVertexArray(), InstanceBindingIndex, stream.GetBuffer(), offset, sizeof(InstanceData));
+
+    mesh.DrawInstanced(static_cast<int>(count));
+}
+
+int InstancedRenderer::GetDrawCallCount() const
+{
+    return drawCallCount;
+}
+
+std::size_t InstancedRenderer::GetInstanceCount() const
+{
+    return instanceCount;
+}
+
+InstancedRenderer::Batch& InstancedRenderer::GetBatch(const Mesh& mesh)
+{
+    for (Batch& batch : batches)
+    {
+        if (batch.mesh == &mesh)
+            return batch;
+    }
+
+    Batch& batch = batches.emplace_back();
+    batch.mesh = &mesh;
+
+    return batch;
+}
+
+void InstancedRenderer::ConfigureVertexArray(Batch& batch)
+{
+    if (batch.vertexArrayConfigured)
+        return;
+
+    batch.vertexArrayConfigured = true;
+
+    const unsigned int vao = batch.mesh->GetVertexArray();
+
+    glVertexArrayBindingDivisor(vao, InstanceBindingIndex, 1);
+
+    // mat4 = 4 egymást követő vec4 attribútum
+    for (unsigned int column = 0; column < 4; ++column)
+    {
+        const unsigned int attribute = FirstInstanceAttribute + column;
+
+        glEnableVertexArrayAttrib(vao, attribute);
+        glVertexArrayAttribFormat(vao, attribute, 4, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(InstanceData, model) + column * sizeof(glm::vec4)));
+        glVertexArrayAttribBinding(vao, attribute, InstanceBindingIndex);
+    }
+
+    const unsigned int colorAttribute = FirstInstanceAttribute + 4;
+
+    glEnableVertexArrayAttrib(vao, colorAttribute);
+    glVertexArrayAttribFormat(vao, colorAttribute, 4, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(InstanceData, color)));
+    glVertexArrayAttribBinding(vao, colorAttribute, InstanceBindingIndex);
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include "MeshFile.h"
+#include "StreamBuffer.h"
+
+class Mesh;
+
+// Példányonkénti adat az instance bufferben (a vertex shader 2-6. attribútuma)
+struct InstanceData
+{
+    glm::mat4 model;
+    glm::vec4 color; // w: useVertexColor (0 vagy 1)
+};
+
+// Képkockánként összegyűjti a kirajzolandó entitásokat, és meshenként
+// egyetlen glDrawElementsInstanced hívással rajzolja ki őket. A példány
+// adat a stream bufferbe kerül, a mesh VAO-ja oda mutat.
+class InstancedRenderer
+{
+public:
+    explicit InstancedRenderer(StreamBuffer& stream);
+
+    InstancedRenderer(const InstancedRenderer&) = delete;
+    InstancedRenderer& operator=(const InstancedRenderer&) = delete;
+
+    // Kiüríti a gyűjtött példányokat (a bufferek megmaradnak)
+    void Begin();
+
+    void Submit(const Mesh& mesh, const glm::mat4& model, const glm::vec3& color, bool useVertexColor);
+
+    // Feltölti az instance buffereket és kirajzol; a shadert a hívó állítja be
+    void Flush();
+
+    // Hely count példánynak a stream bufferben; a hívó tölti ki, akár munkaszálakról.
+    // Betelt stream buffernél érvénytelen (a DrawBatch ekkor nem rajzol).
+    StreamAllocation AllocateInstances(std::size_t count);
+
+    // Egy foglalás [first, first + count) példányainak azonnali rajzolása (RenderQueue);
+    // a Begin/Submit gyűjtést nem érinti, a statisztikába nem számít bele
+    void DrawBatch(const Mesh& mesh, const StreamAllocation& instances, std::size_t first, std::size_t count);
+
+    // az utolsó Flush statisztikája
+    int GetDrawCallCount() const;
+    std::size_t GetInstanceCount() const;
+
+private:
+    // a mesh VAO-jában a 0. és 1. binding a vertex adaté
+    static constexpr unsigned int InstanceBindingIndex = 2;
+    static constexpr unsigned int FirstInstanceAttribute = MeshFileFirstInstanceLocation;
+
+    struct Batch
+    {
+        const Mesh* mesh = nullptr;
+        std::vector<InstanceData> instances;
+
+        bool vertexArrayConfigured = false;
+    };
+
+    Batch& GetBatch(const Mesh& mesh);
+    void ConfigureVertexArray(Batch& batch);
+
+private:
+    StreamBuffer& stream;
+
+    std::vector<Batch> batches; // kevés mesh van, lineáris keresés elég
+
+    int drawCallCount = 0;
+    std::size_t instanceCount = 0;
+};
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include "JobBenchmark.h"
+
+#ifdef ENGINE_BENCHMARKS
+
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t ParallelForItemCount = 1 << 20;
+    constexpr std::size_t ParallelForGrainSize = 1024;
+    constexpr int ItemWorkIterations = 64;
+
+    constexpr std::size_t TinyJobCount = 16384;
+    constexpr int TinyJobWorkIterations = 256;
+
+    constexpr int BenchmarkIterationCount = 5;
+
+    // függőségi láncok: párhuzamos láncok, mindegyik job az előzőre vár
+    constexpr int ChainCount = 4;
+    constexpr int ChainLength = 8;
+    constexpr int ChainTrialCount = 200;
+
+    struct BenchmarkResult
+    {
+        double seconds = 0.0;
+        std::uint64_t checksum = 0;
+    };
+
+    // elemenként néhány tucat lebegőpontos lépés, a memória nem korlátoz
+    float ItemWork(std::size_t index, int iterations)
+    {
+        float value = static_cast<float>(index & 1023) * 0.001f;
+
+        for (int i = 0; i < iterations; ++i)
+        {
+            value = value * 0.999f + 0.5f / (1.0f + value * value);
+        }
+
+        return value;
+    }
+
+    std::uint64_t Checksum(const std::vector<float>& values)
+    {
+        std::uint64_t checksum = 0;
+
+        for (float value : values)
+        {
+            checksum = checksum * 31 + std::bit_cast<std::uint32_t>(value);
+        }
+
+        return checksum;
+    }
+
+    template <typename Work>
+    BenchmarkResult Measure(Work&& work)
+    {
+        BenchmarkResult result;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int iteration = 0; iteration < BenchmarkIterationCount; ++iteration)
+        {
+            result.checksum = work();
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        result.seconds = std::chrono::duration<double>(end - start).count() / BenchmarkIterationCount;
+
+        return result;
+    }
+
+    struct TinyJob
+    {
+        std::vector<float>* output = nullptr;
+        std::size_t index = 0;
+
+        void operator()() const
+        {
+            (*output)[index] = ItemWork(index, TinyJobWorkIterations);
+        }
+    };
+
+    void SpinFor(std::chrono::microseconds duration)
+    {
+        const auto end = std::chrono::steady_clock::now() + duration;
+
+        while (std::chrono::steady_clock::now() < end)
+        {
+        }
+    }
+
+    struct ChainJob
+    {
+        std::atomic<int>* sequence = nullptr; // a lánc következő sorszáma
+        int position = 0;
+        int* outOrder = nullptr;              // ahányadikként futott
+
+        void operator()() const
+        {
+            // a lánc eleje lassú, hogy a függők a deque-kben várjanak rá
+            if (position == 0)
+                SpinFor(std::chrono::microseconds(1000));
+
+            *outOrder = sequence->fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    // Láncok, ahol minden job az előző számlálójára vár, és a fő szál a
+    // beadás után még mással foglalkozik. Ha egy szál felvenne egy függő jobot
+    // és várna rá, a várakozás alatt a lánc későbbi jobjait is felvehetné, és
+    // holtpontra jutna: ez a teszt ilyenkor nem tér vissza. Visszatéréskor
+    // ellenőrzi, hogy minden láncban sorban futottak a jobok.
+    bool RunDependencyChains(JobSystem& jobs)
+    {
+        for (int trial = 0; trial < ChainTrialCount; ++trial)
+        {
+            std::array<std::array<JobCounter, ChainLength>, ChainCount> counters;
+            std::array<std::array<ChainJob, ChainLength>, ChainCount> chainJobs;
+            std::array<std::array<int, ChainLength>, ChainCount> order = {};
+            std::array<std::atomic<int>, ChainCount> sequences = {};
+
+            for (int chain = 0; chain < ChainCount; ++chain)
+            {
+                for (int position = 0; position < ChainLength; ++position)
+                {
+                    ChainJob& job = chainJobs[chain][position];
+                    job.sequence = &sequences[chain];
+                    job.position = position;
+                    job.outOrder = &order[chain][position];
+
+                    const JobCounter* dependency = position > 0 ? &counters[chain][position - 1] : nullptr;
+                    jobs.Run(counters[chain][position], job, dependency);
+                }
+            }
+
+            // a fő szál közben mást csinál, a láncokat a munkaszálak kezdik el
+            SpinFor(std::chrono::microseconds(trial % 4 * 1000));
+
+            for (int chain = 0; chain < ChainCount; ++chain)
+            {
+                jobs.Wait(counters[chain][ChainLength - 1]);
+            }
+
+            bool inOrder = true;
+
+            // a számlálók csak akkor szűnhetnek meg, ha a láncuk mind lefutott
+            for (int chain = 0; chain < ChainCount; ++chain)
+            {
+                for (int position = 0; position < ChainLength; ++position)
+                {
+                    jobs.Wait(counters[chain][position]);
+                    inOrder = inOrder && order[chain][position] == position;
+                }
+            }
+
+            if (!inOrder)
+                return false;
+        }
+
+        return true;
+    }
+
+    void Report(const char* name, int threadCount, const BenchmarkResult& result, const BenchmarkResult& reference)
+    {
+        const double speedup = reference.seconds / result.seconds;
+
+        std::cout
+            << "  " << name << " x" << threadCount << ": "
+            << result.seconds * 1000.0 << " ms, x" << speedup
+            << ", " << speedup / threadCount * 100.0 << "% efficiency"
+            << (result.checksum == reference.checksum ? "" : "  MISMATCH")
+            << "\n";
+    }
+}
+
+void RunJobSystemBenchmark()
+{
+    const int hardwareThreads = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, JobSystem::MaxThreadCount);
+
+    // 1, 2, 4, ... és végül a hardver szálszáma
+    std::vector<int> threadCounts;
+    for (int count = 1; count < hardwareThreads; count *= 2)
+    {
+        threadCounts.push_back(count);
+    }
+    threadCounts.push_back(hardwareThreads);
+
+    std::cout
+        << "Job system benchmark (" << hardwareThreads << " hardware threads, "
+        << ParallelForItemCount << " items / " << TinyJobCount << " tiny jobs)\n";
+
+    std::vector<float> output(std::max(ParallelForItemCount, TinyJobCount));
+
+    std::vector<TinyJob> tinyJobs(TinyJobCount);
+    for (std::size_t i = 0; i < TinyJobCount; ++i)
+    {
+        tinyJobs[i].output = &output;
+        tinyJobs[i].index = i;
+    }
+
+    BenchmarkResult parallelForReference;
+    BenchmarkResult tinyJobReference;
+
+    for (int threadCount : threadCounts)
+    {
+        JobSystem jobs(threadCount);
+
+        BenchmarkResult parallelFor = Measure([&]()
+        {
+            output.assign(output.size(), 0.0f);
+
+            jobs.ParallelFor(ParallelForItemCount, ParallelForGrainSize, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    output[i] = ItemWork(i, ItemWorkIterations);
+                }
+            });
+
+            return Checksum(output);
+        });
+
+        // a beadás és a lopás költsége: jobonként egy Run
+        BenchmarkResult tinyJob = Measure([&]()
+        {
+            output.assign(output.size(), 0.0f);
+
+            JobCounter counter;
+            for (const TinyJob& job : tinyJobs)
+            {
+                jobs.Run(counter, job);
+            }
+            jobs.Wait(counter);
+
+            return Checksum(output);
+        });
+
+        if (threadCount == 1)
+        {
+            parallelForReference = parallelFor;
+            tinyJobReference = tinyJob;
+        }
+
+        Report("parallel for", threadCount, parallelFor, parallelForReference);
+        Report("tiny jobs   ", threadCount, tinyJob, tinyJobReference);
+
+        std::cout
+            << "  dependency chains x" << threadCount << ": "
+            << ChainTrialCount << " trials of " << ChainCount << " x " << ChainLength << " jobs "
+            << (RunDependencyChains(jobs) ? "in order" : "OUT OF ORDER")
+            << "\n";
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+#ifdef ENGINE_BENCHMARKS
+
+// A job rendszer skálázódása 1..N szálon (N a hardver szálszáma): egy
+// számításigényes ParallelFor és sok apró, külön beadott job. A szálanként
+// mért gyorsulást és hatékonyságot (gyorsulás / szálszám) írja ki, és
+// ellenőrzi, hogy az eredmény minden szálszámon ugyanaz. Minden szálszámon
+// függőségi láncokat is futtat (stresszteszt: holtpontnál nem tér vissza).
+void RunJobSystemBenchmark();
+
+#endif
\ No newline at end of file
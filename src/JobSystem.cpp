@@ -0,0 +1,378 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+namespace
+{
+    // ennyi sikertelen keresés után alszik el a munkaszál
+    constexpr int IdleSpinCount = 64;
+
+    // egyszerre parkoló jobok száma, amíg nem kell foglalni
+    constexpr std::size_t ParkedJobReserve = 64;
+
+    // a szál melyik rendszerhez és melyik deque-hez tartozik
+    thread_local const JobSystem* currentJobSystem = nullptr;
+    thread_local int currentThreadIndex = 0;
+
+    std::uint32_t NextRandom(std::uint32_t& state)
+    {
+        // xorshift32: a lopási sorrend szórására elég
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+}
+
+// ---- WorkStealingDeque ----
+
+void JobSystem::WorkStealingDeque::Slot::Store(const Job& job)
+{
+    function.store(job.function, std::memory_order_relaxed);
+    context.store(job.context, std::memory_order_relaxed);
+    first.store(job.first, std::memory_order_relaxed);
+    last.store(job.last, std::memory_order_relaxed);
+    grainSize.store(job.grainSize, std::memory_order_relaxed);
+    counter.store(job.counter, std::memory_order_relaxed);
+    dependency.store(job.dependency, std::memory_order_relaxed);
+}
+
+JobSystem::Job JobSystem::WorkStealingDeque::Slot::Load() const
+{
+    Job job;
+    job.function = function.load(std::memory_order_relaxed);
+    job.context = context.load(std::memory_order_relaxed);
+    job.first = first.load(std::memory_order_relaxed);
+    job.last = last.load(std::memory_order_relaxed);
+    job.grainSize = grainSize.load(std::memory_order_relaxed);
+    job.counter = counter.load(std::memory_order_relaxed);
+    job.dependency = dependency.load(std::memory_order_relaxed);
+
+    return job;
+}
+
+bool JobSystem::WorkStealingDeque::Push(const Job& job)
+{
+    const std::int64_t b = bottom.load(std::memory_order_relaxed);
+    const std::int64_t t = top.load(std::memory_order_acquire);
+
+    if (b - t >= Capacity)
+        return false;
+
+    slots[b & (Capacity - 1)].Store(job);
+
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+
+    return true;
+}
+
+bool JobSystem::WorkStealingDeque::Pop(Job& outJob)
+{
+    const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    std::int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b)
+    {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    outJob = slots[b & (Capacity - 1)].Load();
+
+    if (t != b)
+        return true;
+
+    // az utolsó elemért a tolvajokkal versenyzünk
+    const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_relaxed);
+
+    return won;
+}
+
+bool JobSystem::WorkStealingDeque::Steal(Job& outJob)
+{
+    std::int64_t t = top.load(std::memory_order_acquire);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    const std::int64_t b = bottom.load(std::memory_order_acquire);
+
+    if (t >= b)
+        return false;
+
+    const Job job = slots[t & (Capacity - 1)].Load();
+
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return false;
+
+    outJob = job;
+    return true;
+}
+
+// ---- JobSystem ----
+
+JobSystem::JobSystem(int threadCount)
+    : threadCount(threadCount)
+{
+    if (this->threadCount <= 0)
+    {
+        this->threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+
+    this->threadCount = std::clamp(this->threadCount, 1, MaxThreadCount);
+
+    for (int i = 0; i < this->threadCount; ++i)
+    {
+        threads.push_back(std::make_unique<ThreadState>());
+        threads.back()->random = 0x9E3779B9u * static_cast<std::uint32_t>(i + 1);
+    }
+
+    parkedJobs.reserve(ParkedJobReserve);
+
+    currentJobSystem = this;
+    currentThreadIndex = 0;
+
+    workers.reserve(this->threadCount - 1);
+
+    for (int i = 1; i < this->threadCount; ++i)
+    {
+        workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    running.store(false);
+
+    wakeGeneration.fetch_add(1);
+    wakeGeneration.notify_all();
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    if (currentJobSystem == this)
+    {
+        currentJobSystem = nullptr;
+    }
+}
+
+int JobSystem::GetThreadCount() const
+{
+    return threadCount;
+}
+
+int JobSystem::GetCurrentThreadIndex() const
+{
+    return currentJobSystem == this ? currentThreadIndex : 0;
+}
+
+void JobSystem::Wait(const JobCounter& counter)
+{
+    while (!counter.IsDone())
+    {
+        if (!RunPendingJob())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::RunPendingJob()
+{
+    Job job;
+
+    if (!FindJob(GetCurrentThreadIndex(), job))
+        return false;
+
+    Execute(job);
+    return true;
+}
+
+void JobSystem::Submit(const Job& job)
+{
+    job.counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    // A függő job nem indulhat el, amíg a függősége fut: ha egy szál
+    // felvenné és várna rá, a várakozás alatt a saját vermén lévő
+    // függőségre épülő jobokat is felvehetné, és a lánc holtpontra jutna.
+    if (job.dependency != nullptr && !job.dependency->IsDone())
+    {
+        Park(job);
+        return;
+    }
+
+    Push(job);
+}
+
+void JobSystem::Push(const Job& job)
+{
+    // tele deque-nél helyben futtatjuk, ez a rekurzív felezést is korlátozza
+    if (!threads[GetCurrentThreadIndex()]->deque.Push(job))
+    {
+        Execute(job);
+        return;
+    }
+
+    // A munkaszál elalvás előtt növeli a sleepingCount-ot, majd újra keres:
+    // a fence miatt vagy ő látja az új jobot, vagy mi látjuk, hogy alszik.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (sleepingCount.load(std::memory_order_relaxed) > 0)
+    {
+        wakeGeneration.fetch_add(1, std::memory_order_release);
+        wakeGeneration.notify_one();
+    }
+}
+
+void JobSystem::Park(const Job& job)
+{
+    {
+        std::lock_guard<std::mutex> lock(parkedMutex);
+
+        parkedJobs.push_back(job);
+
+        // A befejező szál a nullázás után nézi a parkedCount-ot, mi a parkolás
+        // után a függőséget (seq_cst): vagy ő engedi el a jobot, vagy mi
+        // látjuk a nullát. A zár alatt a job nem indulhat el, így a függőség
+        // számlálója is biztosan él még.
+        parkedCount.fetch_add(1, std::memory_order_seq_cst);
+
+        if (job.dependency->pending.load(std::memory_order_seq_cst) != 0)
+            return;
+
+        parkedJobs.pop_back();
+        parkedCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    Push(job);
+}
+
+void JobSystem::ReleaseParkedJobs()
+{
+    // egyesével, a zár nélkül tesszük sorba: tele deque-nél a Push helyben
+    // futtat, az pedig újra ide juthat
+    while (true)
+    {
+        Job job;
+
+        {
+            std::lock_guard<std::mutex> lock(parkedMutex);
+
+            auto ready = std::find_if(parkedJobs.begin(), parkedJobs.end(), [](const Job& parked)
+            {
+                return parked.dependency->IsDone();
+            });
+
+            if (ready == parkedJobs.end())
+                return;
+
+            job = *ready;
+            *ready = parkedJobs.back();
+            parkedJobs.pop_back();
+        }
+
+        parkedCount.fetch_sub(1, std::memory_order_relaxed);
+        Push(job);
+    }
+}
+
+bool JobSystem::FindJob(int threadIndex, Job& outJob)
+{
+    ThreadState& thread = *threads[threadIndex];
+
+    if (thread.deque.Pop(outJob))
+        return true;
+
+    if (threadCount == 1)
+        return false;
+
+    const int start = static_cast<int>(NextRandom(thread.random) % static_cast<std::uint32_t>(threadCount));
+
+    for (int i = 0; i < threadCount; ++i)
+    {
+        const int victim = (start + i) % threadCount;
+
+        if (victim != threadIndex && threads[victim]->deque.Steal(outJob))
+            return true;
+    }
+
+    return false;
+}
+
+void JobSystem::Execute(Job job)
+{
+    // a tartomány jobb fele új job lesz (ezt lophatják el), a bal felét itt folytatjuk
+    while (job.last - job.first > job.grainSize)
+    {
+        Job right = job;
+        right.first = job.first + (job.last - job.first) / 2;
+        right.dependency = nullptr;
+
+        job.last = right.first;
+
+        Submit(right);
+    }
+
+    job.function(job.context, job.first, job.last);
+
+    // A nullázás után a számlálóhoz már nem nyúlunk, a várakozó szál törölheti
+    const bool counterDone = job.counter->pending.fetch_sub(1, std::memory_order_seq_cst) == 1;
+
+    if (counterDone && parkedCount.load(std::memory_order_seq_cst) > 0)
+    {
+        ReleaseParkedJobs();
+    }
+}
+
+void JobSystem::WorkerLoop(int threadIndex)
+{
+    currentJobSystem = this;
+    currentThreadIndex = threadIndex;
+
+    int idleCount = 0;
+
+    while (running.load(std::memory_order_relaxed))
+    {
+        Job job;
+
+        if (FindJob(threadIndex, job))
+        {
+            Execute(job);
+            idleCount = 0;
+            continue;
+        }
+
+        if (++idleCount < IdleSpinCount)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        idleCount = 0;
+
+        // a generációt a végső keresés előtt olvassuk: ami utána jön, felébreszt
+        const std::uint32_t generation = wakeGeneration.load(std::memory_order_acquire);
+        sleepingCount.fetch_add(1, std::memory_order_seq_cst);
+
+        if (FindJob(threadIndex, job))
+        {
+            sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+            Execute(job);
+            continue;
+        }
+
+        if (running.load(std::memory_order_relaxed))
+        {
+            wakeGeneration.wait(generation, std::memory_order_acquire);
+        }
+
+        sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
\ No newline at end of file
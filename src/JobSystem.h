@@ -0,0 +1,197 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Számláló egy jobcsoporthoz: a Run növeli, a kész job csökkenti.
+// A Wait-ig (és a rá váró jobok elindulásáig) élnie kell.
+class JobCounter
+{
+public:
+    JobCounter() = default;
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool IsDone() const
+    {
+        return pending.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<int> pending{ 0 };
+};
+
+// Work-stealing ütemező. Minden szálnak (a létrehozó szál a 0.) saját
+// Chase-Lev deque-je van: a saját végére tesz és onnan vesz (LIFO, meleg
+// cache), a tétlen szálak a többi deque másik végéről lopnak (FIFO, a
+// nagyobb, korábban beadott darabok). A várakozó szál (Wait) nem alszik,
+// hanem jobokat futtat, amíg a számláló nullára nem ér.
+//
+// A jobok nem foglalnak heapet: érték szerint a deque slotjaiba kerülnek.
+// Jobot csak a létrehozó szál és a munkaszálak adhatnak be.
+class JobSystem
+{
+public:
+    static constexpr int MaxThreadCount = 64;
+
+    // threadCount <= 0: a hardver szálszáma. A hívó szál is dolgozik
+    // (a Wait alatt), így threadCount - 1 munkaszál indul.
+    explicit JobSystem(int threadCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    int GetThreadCount() const;
+
+    // 0 a létrehozó szálon, 1..threadCount-1 a munkaszálakon
+    int GetCurrentThreadIndex() const;
+
+    // A function()-t jobként futtatja. A függvény a Wait-ig élnie kell (a job
+    // csak hivatkozik rá). Ha van dependency, a job addig parkol, amíg az
+    // nullára nem ér, és csak utána kerül deque-be: egy szál sem blokkol rá.
+    template <typename Function>
+    void Run(JobCounter& counter, const Function& function, const JobCounter* dependency = nullptr)
+    {
+        Job job;
+        job.function = [](const void* context, std::size_t, std::size_t)
+        {
+            (*static_cast<const Function*>(context))();
+        };
+        job.context = &function;
+        job.first = 0;
+        job.last = 1;
+        job.grainSize = 1;
+        job.counter = &counter;
+        job.dependency = dependency;
+
+        Submit(job);
+    }
+
+    // Futtatás a számláló nulláig; közben a szál a sorban álló jobokat végzi
+    void Wait(const JobCounter& counter);
+
+    // Legfeljebb egy sorban álló jobot futtat a hívó szálon; false, ha nem
+    // volt munka. Saját várakozó ciklushoz (pl. a fő szálhoz kötött munkák mellé).
+    bool RunPendingJob();
+
+    // function(first, last) a [0, count) darabjaira, legfeljebb grainSize
+    // eleműekre. A tartomány felezéssel oszlik: a szálak a nagy feleket lopják
+    // el, a kicsiket helyben futtatják. Visszatéréskor minden darab kész.
+    template <typename Function>
+    void ParallelFor(std::size_t count, std::size_t grainSize, const Function& function)
+    {
+        if (count == 0)
+            return;
+
+        JobCounter counter;
+
+        Job job;
+        job.function = [](const void* context, std::size_t first, std::size_t last)
+        {
+            (*static_cast<const Function*>(context))(first, last);
+        };
+        job.context = &function;
+        job.first = 0;
+        job.last = count;
+        job.grainSize = grainSize > 0 ? grainSize : 1;
+        job.counter = &counter;
+
+        Submit(job);
+        Wait(counter);
+    }
+
+private:
+    struct Job
+    {
+        void (*function)(const void* context, std::size_t first, std::size_t last) = nullptr;
+        const void* context = nullptr;
+
+        std::size_t first = 0;
+        std::size_t last = 0;
+        std::size_t grainSize = 1; // ennél nagyobb tartományt a futtatás kettévág
+
+        JobCounter* counter = nullptr;
+        const JobCounter* dependency = nullptr;
+    };
+
+    // Chase-Lev deque rögzített kapacitással (Lê et al. 2013, C11 atomikkal).
+    // A slot mezői relaxed atomikusak: a tolvaj a CAS előtt másol, és csak
+    // sikeres CAS után használja a másolatot.
+    class WorkStealingDeque
+    {
+    public:
+        static constexpr std::int64_t Capacity = 1024;
+
+        bool Push(const Job& job);  // csak a tulajdonos; false, ha tele
+        bool Pop(Job& outJob);      // csak a tulajdonos
+        bool Steal(Job& outJob);    // bármelyik szál
+
+    private:
+        struct Slot
+        {
+            std::atomic<void (*)(const void*, std::size_t, std::size_t)> function;
+            std::atomic<const void*> context;
+            std::atomic<std::size_t> first;
+            std::atomic<std::size_t> last;
+            std::atomic<std::size_t> grainSize;
+            std::atomic<JobCounter*> counter;
+            std::atomic<const JobCounter*> dependency;
+
+            void Store(const Job& job);
+            Job Load() const;
+        };
+
+        alignas(64) std::atomic<std::int64_t> top{ 0 };
+        alignas(64) std::atomic<std::int64_t> bottom{ 0 };
+        alignas(64) Slot slots[Capacity];
+    };
+
+    struct ThreadState
+    {
+        WorkStealingDeque deque;
+        std::uint32_t random = 0; // lopási áldozat választásához
+    };
+
+    void Submit(const Job& job);
+
+    // A saját deque-be teszi (tele deque-nél helyben futtatja), és ébreszt
+    void Push(const Job& job);
+
+    // A még nem teljesült függőségű jobot félreteszi; ha közben teljesült, sorba teszi
+    void Park(const Job& job);
+
+    // A teljesült függőségű parkoló jobokat a hívó szál deque-jébe teszi
+    void ReleaseParkedJobs();
+
+    // Saját deque, majd lopás; false, ha most nincs munka
+    bool FindJob(int threadIndex, Job& outJob);
+    void Execute(Job job);
+
+    void WorkerLoop(int threadIndex);
+
+private:
+    int threadCount;
+
+    std::vector<std::unique_ptr<ThreadState>> threads;
+    std::vector<std::thread> workers;
+
+    std::atomic<bool> running{ true };
+
+    // alvó munkaszálak ébresztése: a Submit lépteti a generációt
+    std::atomic<int> sleepingCount{ 0 };
+    std::atomic<std::uint32_t> wakeGeneration{ 0 };
+
+    // függőségre váró jobok; a kapacitás megmarad, bemelegedés után nem foglal
+    std::mutex parkedMutex;
+    std::vector<Job> parkedJobs;
+    std::atomic<int> parkedCount{ 0 };
+};
\ No newline at end of file
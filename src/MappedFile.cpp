@@ -0,0 +1,143 @@
+#include "MappedFile.h"
+
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        std::cerr << "File open error: " << path << "\n";
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        std::cerr << "File is empty: " << path << "\n";
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+    if (view == nullptr)
+    {
+        std::cerr << "File mapping error: " << path << "\n";
+
+        if (mapping != nullptr)
+            CloseHandle(mapping);
+
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const std::byte*>(view);
+    size = static_cast<std::size_t>(fileSize.QuadPart);
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data != nullptr)
+        UnmapViewOfFile(data);
+
+    if (mappingHandle != nullptr)
+        CloseHandle(mappingHandle);
+
+    if (fileHandle != nullptr)
+        CloseHandle(fileHandle);
+
+    data = nullptr;
+    size = 0;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+
+    const int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        std::cerr << "File open error: " << path << "\n";
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size == 0)
+    {
+        std::cerr << "File is empty: " << path << "\n";
+        close(file);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+    // a leképezés a leíró bezárása után is érvényes marad
+    close(file);
+
+    if (view == MAP_FAILED)
+    {
+        std::cerr << "File mapping error: " << path << "\n";
+        return false;
+    }
+
+    data = static_cast<const std::byte*>(view);
+    size = static_cast<std::size_t>(status.st_size);
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data != nullptr)
+        munmap(const_cast<std::byte*>(data), size);
+
+    data = nullptr;
+    size = 0;
+}
+
+#endif
+
+bool MappedFile::IsOpen() const
+{
+    return data != nullptr;
+}
+
+const std::byte* MappedFile::GetData() const
+{
+    return data;
+}
+
+std::size_t MappedFile::GetSize() const
+{
+    return size;
+}
\ No newline at end of file
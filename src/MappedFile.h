@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Csak olvasható, memóriába leképezett fájl (Windows: MapViewOfFile, máshol mmap).
+// Az oldalakat az OS tölti be az első hozzáféréskor, a tartalom nem másolódik.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Hibánál üzenetet ír és false-t ad vissza (a korábbi leképezés ekkor is bezárul)
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const;
+    const std::byte* GetData() const;
+    std::size_t GetSize() const;
+
+private:
+    const std::byte* data = nullptr;
+    std::size_t size = 0;
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
\ No newline at end of file
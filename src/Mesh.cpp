@@ -1,97 +1,102 @@
 #include "Mesh.h"
-#include <cmath>
+#include "MeshData.h"
+#include "MeshFile.h"
+#include "MeshOptimizer.h"
 
+#include <cstddef>
 #include <glad/glad.h>
 
+namespace
+{
+    MeshData MakeOptimizedCube()
+    {
+        MeshData cube = MakeCubeMeshData();
+        OptimizeMesh(cube);
+
+        return cube;
+    }
+}
+
 Mesh::Mesh()
+    : Mesh(MakeOptimizedCube())
+{
+}
+
+Mesh::Mesh(const MeshData& data)
+{
+    Upload(
+        data.vertices.data(), data.vertices.size() * sizeof(MeshVertex), sizeof(MeshVertex),
+        MeshVertexAttributes, static_cast<std::uint32_t>(std::size(MeshVertexAttributes)),
+        data.indices.data(), data.indices.size());
+}
+
+Mesh::Mesh(const MeshFile& file)
+{
+    const MeshFileHeader& header = file.GetHeader();
+
+    Upload(
+        file.GetVertexData(), file.GetVertexDataSize(), header.vertexStride,
+        header.attributes, header.attributeCount,
+        file.GetIndexData(), file.GetIndexCount());
+}
+
+void Mesh::Upload(
+    const void* vertexData,
+    std::size_t vertexDataSize,
+    std::uint32_t vertexStride,
+    const MeshFileAttribute* attributes,
+    std::uint32_t attributeCount,
+    const std::uint32_t* indexData,
+    std::size_t indexCount)
 {
-    constexpr float HalfSize = 0.5f;
+    this->indexCount = static_cast<int>(indexCount);
+
+    glCreateVertexArrays(1, &vao);
+    glCreateBuffers(1, &vbo);
+    glCreateBuffers(1, &ebo);
 
-    constexpr float Red[] = { 1.0f, 0.0f, 0.0f };
-    constexpr float Green[] = { 0.0f, 1.0f, 0.0f };
-    constexpr float Blue[] = { 0.0f, 0.0f, 1.0f };
+    glNamedBufferStorage(vbo, static_cast<GLsizeiptr>(vertexDataSize), vertexData, 0);
+    glNamedBufferStorage(ebo, static_cast<GLsizeiptr>(indexCount * sizeof(std::uint32_t)), indexData, 0);
 
-    float vertices[] =
+    // a 0. binding a vertex buffer, az instance adat a 2.-on jn (InstancedRenderer)
+    glVertexArrayVertexBuffer(vao, 0, vbo, 0, static_cast<GLsizei>(vertexStride));
+    glVertexArrayElementBuffer(vao, ebo);
+
+    for (std::uint32_t i = 0; i < attributeCount; ++i)
     {
-        // +X (piros)
-        HalfSize, -HalfSize, -HalfSize,  Red[0], Red[1], Red[2],
-        HalfSize,  HalfSize, -HalfSize,  Red[0], Red[1], Red[2],
-        HalfSize,  HalfSize,  HalfSize,  Red[0], Red[1], Red[2],
-        HalfSize,  HalfSize,  HalfSize,  Red[0], Red[1], Red[2],
-        HalfSize, -HalfSize,  HalfSize,  Red[0], Red[1], Red[2],
-        HalfSize, -HalfSize, -HalfSize,  Red[0], Red[1], Red[2],
-
-        // -X (piros)
-       -HalfSize, -HalfSize, -HalfSize,  Red[0], Red[1], Red[2],
-       -HalfSize, -HalfSize,  HalfSize,  Red[0], Red[1], Red[2],
-       -HalfSize,  HalfSize,  HalfSize,  Red[0], Red[1], Red[2],
-       -HalfSize,  HalfSize,  HalfSize,  Red[0], Red[1], Red[2],
-       -HalfSize,  HalfSize, -HalfSize,  Red[0], Red[1], Red[2],
-       -HalfSize, -HalfSize, -HalfSize,  Red[0], Red[1], Red[2],
-
-       // +Y (zld)
-      -HalfSize,  HalfSize, -HalfSize,  Green[0], Green[1], Green[2],
-      -HalfSize,  HalfSize,  HalfSize,  Green[0], Green[1], Green[2],
-       HalfSize,  HalfSize,  HalfSize,  Green[0], Green[1], Green[2],
-       HalfSize,  HalfSize,  HalfSize,  Green[0], Green[1], Green[2],
-       HalfSize,  HalfSize, -HalfSize,  Green[0], Green[1], Green[2],
-      -HalfSize,  HalfSize, -HalfSize,  Green[0], Green[1], Green[2],
-
-      // -Y (zld)
-     -HalfSize, -HalfSize, -HalfSize,  Green[0], Green[1], Green[2],
-      HalfSize, -HalfSize, -HalfSize,  Green[0], Green[1], Green[2],
-      HalfSize, -HalfSize,  HalfSize,  Green[0], Green[1], Green[2],
-      HalfSize, -HalfSize,  HalfSize,  Green[0], Green[1], Green[2],
-     -HalfSize, -HalfSize,  HalfSize,  Green[0], Green[1], Green[2],
-     -HalfSize, -HalfSize, -HalfSize,  Green[0], Green[1], Green[2],
-
-     // +Z (kk)
-    -HalfSize, -HalfSize,  HalfSize,  Blue[0], Blue[1], Blue[2],
-     HalfSize, -HalfSize,  HalfSize,  Blue[0], Blue[1], Blue[2],
-     HalfSize,  HalfSize,  HalfSize,  Blue[0], Blue[1], Blue[2],
-     HalfSize,  HalfSize,  HalfSize,  Blue[0], Blue[1], Blue[2],
-    -HalfSize,  HalfSize,  HalfSize,  Blue[0], Blue[1], Blue[2],
-    -HalfSize, -HalfSize,  HalfSize,  Blue[0], Blue[1], Blue[2],
-
-    // -Z (kk)
-   -HalfSize, -HalfSize, -HalfSize,  Blue[0], Blue[1], Blue[2],
-   -HalfSize,  HalfSize, -HalfSize,  Blue[0], Blue[1], Blue[2],
-    HalfSize,  HalfSize, -HalfSize,  Blue[0], Blue[1], Blue[2],
-    HalfSize,  HalfSize, -HalfSize,  Blue[0], Blue[1], Blue[2],
-    HalfSize, -HalfSize, -HalfSize,  Blue[0], Blue[1], Blue[2],
-   -HalfSize, -HalfSize, -HalfSize,  Blue[0], Blue[1], Blue[2],
-    };
-
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
+        const MeshFileAttribute& attribute = attributes[i];
 
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(
-        0, 3, GL_FLOAT, GL_FALSE,
-        6 * sizeof(float),
-        reinterpret_cast<void*>(0));
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(
-        1, 3, GL_FLOAT, GL_FALSE,
-        6 * sizeof(float),
-        reinterpret_cast<void*>(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    glBindVertexArray(0);
+        glEnableVertexArrayAttrib(vao, attribute.location);
+        glVertexArrayAttribFormat(vao, attribute.location, static_cast<GLint>(attribute.componentCount), GL_FLOAT, GL_FALSE, attribute.offset);
+        glVertexArrayAttribBinding(vao, attribute.location, 0);
+    }
 }
 
 Mesh::~Mesh()
 {
     glDeleteVertexArrays(1, &vao);
     glDeleteBuffers(1, &vbo);
+    glDeleteBuffers(1, &ebo);
 }
 
 void Mesh::Draw() const
 {
     glBindVertexArray(vao);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
+}
+
+void Mesh::DrawInstanced(int instanceCount) const
+{
+    glBindVertexArray(vao);
+    glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, instanceCount);
+}
+
+unsigned int Mesh::GetVertexArray() const
+{
+    return vao;
+}
+
+int Mesh::GetIndexCount() const
+{
+    return indexCount;
 }
\ No newline at end of file
@@ -1,14 +1,49 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
+struct MeshData;
+struct MeshFileAttribute;
+class MeshFile;
+
+// Indexelt mesh a GPU-n (vertex + index buffer egy VAO-ban)
 class Mesh
 {
 public:
+    // az egységkocka
     Mesh();
+
+    // A kapott adatot változatlanul tölti fel; az optimalizálás (OptimizeMesh)
+    // a hívó dolga, hogy a már optimalizált (pl. konvertált) adat ne menjen át újra
+    explicit Mesh(const MeshData& data);
+
+    // A leképezett blobokat közvetlenül a GPU bufferbe tölti, köztes másolat nélkül
+    explicit Mesh(const MeshFile& file);
     ~Mesh();
 
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+
     void Draw() const;
+    void DrawInstanced(int instanceCount) const;
+
+    unsigned int GetVertexArray() const;
+    int GetIndexCount() const;
+
+private:
+    void Upload(
+        const void* vertexData,
+        std::size_t vertexDataSize,
+        std::uint32_t vertexStride,
+        const MeshFileAttribute* attributes,
+        std::uint32_t attributeCount,
+        const std::uint32_t* indexData,
+        std::size_t indexCount);
 
 private:
-    unsigned int vao;
-    unsigned int vbo;
+    unsigned int vao = 0;
+    unsigned int vbo = 0;
+    unsigned int ebo = 0;
+    int indexCount = 0;
 };
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "MeshBenchmark.h"
+
+#ifdef ENGINE_BENCHMARKS
+
+#include "Mesh.h"
+#include "MeshData.h"
+#include "MeshFile.h"
+#include "MeshOptimizer.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double Milliseconds(Clock::time_point start, Clock::time_point end)
+    {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    bool WriteObj(const std::string& path, const MeshData& mesh)
+    {
+        std::ofstream stream(path);
+
+        for (const MeshVertex& vertex : mesh.vertices)
+        {
+            stream << "v " << vertex.position.x << " " << vertex.position.y << " " << vertex.position.z << "\n";
+        }
+
+        for (std::size_t i = 0; i < mesh.indices.size(); i += 3)
+        {
+            stream << "f " << mesh.indices[i] + 1 << " " << mesh.indices[i + 1] + 1 << " " << mesh.indices[i + 2] + 1 << "\n";
+        }
+
+        return static_cast<bool>(stream);
+    }
+
+    void MeasureModel(const std::filesystem::path& objPath, const std::filesystem::path& zsmPath)
+    {
+        // szöveg: ezt csinálná az indulás konverter nélkül
+        auto textStart = Clock::now();
+
+        MeshData data;
+        if (!LoadObjMesh(objPath.string(), glm::vec3(1.0f), data))
+            return;
+
+        OptimizeMesh(data);
+        {
+            Mesh mesh(data);
+            glFinish();
+        }
+
+        auto textEnd = Clock::now();
+
+        if (!WriteMeshFile(zsmPath.string(), data))
+            return;
+
+        // bináris: leképezés és feltöltés közvetlenül a leképezett lapokból.
+        // A fájlt az imént írtuk, így a lapjai még a page cache-ben vannak:
+        // ez meleg betöltés, a hideg (lemezről olvasó) eset ennél lassabb.
+        auto binaryStart = Clock::now();
+
+        MeshFile file;
+        if (!file.Open(zsmPath.string()))
+            return;
+        {
+            Mesh mesh(file);
+            glFinish();
+        }
+
+        auto binaryEnd = Clock::now();
+
+        const double textMilliseconds = Milliseconds(textStart, textEnd);
+        const double binaryMilliseconds = Milliseconds(binaryStart, binaryEnd);
+
+        std::cout
+            << "  " << objPath.filename().string() << ": " << data.GetTriangleCount() << " tris, "
+            << "obj " << textMilliseconds << " ms, zsm " << binaryMilliseconds << " ms, x"
+            << textMilliseconds / binaryMilliseconds << "\n";
+    }
+}
+
+void RunMeshLoadBenchmark(const char* modelDirectory)
+{
+    const std::filesystem::path temporary = std::filesystem::temp_directory_path();
+    const std::filesystem::path zsmPath = temporary / "zs_mesh_benchmark.zsm";
+
+    std::vector<std::filesystem::path> models;
+
+    std::error_code error;
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(modelDirectory, error))
+    {
+        if (entry.path().extension() == ".obj")
+            models.push_back(entry.path());
+    }
+
+    // modellek nélkül egy sűrű kapszulával mérünk (kb. egy részletes karakter mérete)
+    std::filesystem::path generated;
+
+    if (models.empty())
+    {
+        MeshData capsule = MakeCapsuleMeshData(0.3f, 1.8f, 256, 128, glm::vec3(1.0f));
+        DeduplicateVertices(capsule);
+
+        generated = temporary / "zs_mesh_benchmark.obj";
+
+        if (!WriteObj(generated.string(), capsule))
+        {
+            std::cerr << "Mesh load benchmark: cannot write " << generated.string() << "\n";
+            return;
+        }
+
+        models.push_back(generated);
+    }
+
+    std::cout << "Mesh load benchmark (including GPU upload; zsm is warm in the page cache, not a cold disk load)\n";
+
+    for (const std::filesystem::path& model : models)
+    {
+        MeasureModel(model, zsmPath);
+    }
+
+    std::filesystem::remove(zsmPath, error);
+
+    if (!generated.empty())
+        std::filesystem::remove(generated, error);
+}
+
+#endif
\ No newline at end of file
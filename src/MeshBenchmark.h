@@ -0,0 +1,10 @@
+#pragma once
+
+#ifdef ENGINE_BENCHMARKS
+
+// Betöltési idő: OBJ szöveg feldolgozás + optimalizálás vs. leképezett .zsm,
+// mindkettő GPU feltöltéssel együtt. A modelDirectory .obj fájljait méri,
+// ha nincs ilyen, egy generált kapszulát. GL kontextus kell hozzá.
+void RunMeshLoadBenchmark(const char* modelDirectory);
+
+#endif
\ No newline at end of file
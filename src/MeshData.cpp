@@ -0,0 +1,211 @@
+#include "MeshData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+    constexpr float HalfPi = 1.57079632679f;
+    constexpr float TwoPi = 6.28318530718f;
+
+    void AddTriangle(MeshData& mesh, const MeshVertex& a, const MeshVertex& b, const MeshVertex& c)
+    {
+        const std::uint32_t first = static_cast<std::uint32_t>(mesh.vertices.size());
+
+        mesh.vertices.push_back(a);
+        mesh.vertices.push_back(b);
+        mesh.vertices.push_back(c);
+
+        mesh.indices.push_back(first);
+        mesh.indices.push_back(first + 1);
+        mesh.indices.push_back(first + 2);
+    }
+
+    // "12", "12/3", "12//5", "12/3/5" -> 12; negatív index a végéről számol
+    bool ParseObjIndex(const std::string& token, std::size_t positionCount, std::uint32_t& outIndex)
+    {
+        int index = 0;
+
+        try
+        {
+            index = std::stoi(token.substr(0, token.find('/')));
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        long long resolved = index > 0 ? index - 1 : static_cast<long long>(positionCount) + index;
+
+        if (index == 0 || resolved < 0 || resolved >= static_cast<long long>(positionCount))
+            return false;
+
+        outIndex = static_cast<std::uint32_t>(resolved);
+        return true;
+    }
+}
+
+MeshData MakeCubeMeshData()
+{
+    constexpr float H = 0.5f;
+
+    constexpr glm::vec3 Red(1.0f, 0.0f, 0.0f);
+    constexpr glm::vec3 Green(0.0f, 1.0f, 0.0f);
+    constexpr glm::vec3 Blue(0.0f, 0.0f, 1.0f);
+
+    // oldalanként két háromszög, a régi glDrawArrays-es kocka sorrendjében
+    const MeshVertex vertices[] =
+    {
+        // +X (piros)
+        { {  H, -H, -H }, Red }, { {  H,  H, -H }, Red }, { {  H,  H,  H }, Red },
+        { {  H,  H,  H }, Red }, { {  H, -H,  H }, Red }, { {  H, -H, -H }, Red },
+
+        // -X (piros)
+        { { -H, -H, -H }, Red }, { { -H, -H,  H }, Red }, { { -H,  H,  H }, Red },
+        { { -H,  H,  H }, Red }, { { -H,  H, -H }, Red }, { { -H, -H, -H }, Red },
+
+        // +Y (zöld)
+        { { -H,  H, -H }, Green }, { { -H,  H,  H }, Green }, { {  H,  H,  H }, Green },
+        { {  H,  H,  H }, Green }, { {  H,  H, -H }, Green }, { { -H,  H, -H }, Green },
+
+        // -Y (zöld)
+        { { -H, -H, -H }, Green }, { {  H, -H, -H }, Green }, { {  H, -H,  H }, Green },
+        { {  H, -H,  H }, Green }, { { -H, -H,  H }, Green }, { { -H, -H, -H }, Green },
+
+        // +Z (kék)
+        { { -H, -H,  H }, Blue }, { {  H, -H,  H }, Blue }, { {  H,  H,  H }, Blue },
+        { {  H,  H,  H }, Blue }, { { -H,  H,  H }, Blue }, { { -H, -H,  H }, Blue },
+
+        // -Z (kék)
+        { { -H, -H, -H }, Blue }, { { -H,  H, -H }, Blue }, { {  H,  H, -H }, Blue },
+        { {  H,  H, -H }, Blue }, { {  H, -H, -H }, Blue }, { { -H, -H, -H }, Blue },
+    };
+
+    MeshData mesh;
+
+    for (std::size_t i = 0; i < std::size(vertices); i += 3)
+    {
+        AddTriangle(mesh, vertices[i], vertices[i + 1], vertices[i + 2]);
+    }
+
+    return mesh;
+}
+
+MeshData MakeCapsuleMeshData(float radius, float height, int segments, int rings, const glm::vec3& color)
+{
+    segments = std::max(segments, 3);
+    rings = std::max(rings, 1);
+
+    const float cylinderTop = std::max(height - radius, radius);
+
+    // sorok alulról felfelé: alsó félgömb (rings + 1 sor), felső félgömb (rings + 1 sor)
+    auto Point = [&](int row, int segment)
+    {
+        const bool top = row > rings;
+        const float t = top
+            ? static_cast<float>(row - rings - 1) / rings
+            : static_cast<float>(row) / rings - 1.0f;
+
+        const float phi = t * HalfPi;
+        const float theta = TwoPi * static_cast<float>(segment % segments) / segments;
+
+        glm::vec3 position(
+            radius * std::cos(phi) * std::cos(theta),
+            (top ? cylinderTop : radius) + radius * std::sin(phi),
+            radius * std::cos(phi) * std::sin(theta));
+
+        // magasság szerinti árnyalás, hogy a forma egyszínűen is olvasható legyen
+        const float shade = 0.6f + 0.4f * position.y / (cylinderTop + radius);
+
+        return MeshVertex{ position, color * shade };
+    };
+
+    const int lastRow = 2 * rings + 1;
+
+    MeshData mesh;
+
+    for (int row = 0; row < lastRow; ++row)
+    {
+        for (int segment = 0; segment < segments; ++segment)
+        {
+            const MeshVertex a = Point(row, segment);
+            const MeshVertex b = Point(row, segment + 1);
+            const MeshVertex c = Point(row + 1, segment + 1);
+            const MeshVertex d = Point(row + 1, segment);
+
+            // a pólusoknál a négyszög egyik háromszöge elfajuló
+            if (row != 0)
+                AddTriangle(mesh, a, c, b);
+
+            if (row != lastRow - 1)
+                AddTriangle(mesh, a, d, c);
+        }
+    }
+
+    return mesh;
+}
+
+bool LoadObjMesh(const std::string& path, const glm::vec3& color, MeshData& outMesh)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "OBJ open error: " << path << "\n";
+        return false;
+    }
+
+    std::vector<glm::vec3> positions;
+    std::vector<std::uint32_t> face;
+
+    outMesh.vertices.clear();
+    outMesh.indices.clear();
+
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+
+        std::istringstream stream(line);
+        std::string keyword;
+        stream >> keyword;
+
+        if (keyword == "v")
+        {
+            glm::vec3 position(0.0f);
+            stream >> position.x >> position.y >> position.z;
+            positions.push_back(position);
+        }
+        else if (keyword == "f")
+        {
+            face.clear();
+
+            std::string token;
+            while (stream >> token)
+            {
+                std::uint32_t index;
+                if (!ParseObjIndex(token, positions.size(), index))
+                {
+                    std::cerr << "OBJ parse error: " << path << ":" << lineNumber << "\n";
+                    return false;
+                }
+
+                face.push_back(index);
+            }
+
+            for (std::size_t i = 2; i < face.size(); ++i)
+            {
+                AddTriangle(outMesh,
+                    { positions[face[0]], color },
+                    { positions[face[i - 1]], color },
+                    { positions[face[i]], color });
+            }
+        }
+    }
+
+    return !outMesh.indices.empty();
+}
\ No newline at end of file
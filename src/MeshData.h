@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/vec3.hpp>
+
+// A Mesh vertex formátuma (0: pozíció, 1: szín), a GPU-ra változatlanul kerül
+struct MeshVertex
+{
+    glm::vec3 position;
+    glm::vec3 color;
+};
+
+// Indexelt háromszöglista CPU oldalon: ezt optimalizáljuk, és ebből épül a Mesh
+struct MeshData
+{
+    std::vector<MeshVertex> vertices;
+    std::vector<std::uint32_t> indices;
+
+    std::size_t GetTriangleCount() const
+    {
+        return indices.size() / 3;
+    }
+};
+
+// Az egységkocka ([-0.5, 0.5]^3), oldalanként színezve, indexeletlen háromszögekkel
+MeshData MakeCubeMeshData();
+
+// Függőleges kapszula a talpától (y = 0) mérve, a zombik helyettesítő modellje
+MeshData MakeCapsuleMeshData(float radius, float height, int segments, int rings, const glm::vec3& color);
+
+// Wavefront OBJ betöltés (csak pozíciók, a sokszögeket legyezőként bontja).
+// Az importerekhez hasonlóan minden sarok külön vertex; a duplikátumokat az
+// optimalizáló szűri ki. Hibánál üzenetet ír és false-t ad vissza.
+bool LoadObjMesh(const std::string& path, const glm::vec3& color, MeshData& outMesh);
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "MeshFile.h"
+#include "MeshData.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <glm/common.hpp>
+
+const MeshFileAttribute MeshVertexAttributes[2] =
+{
+    { 0, 3, static_cast<std::uint32_t>(offsetof(MeshVertex, position)) },
+    { 1, 3, static_cast<std::uint32_t>(offsetof(MeshVertex, color)) },
+};
+
+namespace
+{
+    std::uint64_t AlignBlobOffset(std::uint64_t offset)
+    {
+        return (offset + MeshFileBlobAlignment - 1) & ~static_cast<std::uint64_t>(MeshFileBlobAlignment - 1);
+    }
+
+    void WritePadding(std::ofstream& stream, std::uint64_t from, std::uint64_t to)
+    {
+        const char zeros[MeshFileBlobAlignment] = {};
+        stream.write(zeros, static_cast<std::streamsize>(to - from));
+    }
+}
+
+bool WriteMeshFile(const std::string& path, const MeshData& mesh)
+{
+    if (mesh.vertices.empty() || mesh.indices.empty())
+    {
+        std::cerr << "Mesh file write error (empty mesh): " << path << "\n";
+        return false;
+    }
+
+    MeshFileHeader header = {};
+    header.magic = MeshFileMagic;
+    header.version = MeshFileVersion;
+    header.vertexCount = static_cast<std::uint32_t>(mesh.vertices.size());
+    header.indexCount = static_cast<std::uint32_t>(mesh.indices.size());
+    header.vertexStride = sizeof(MeshVertex);
+    header.attributeCount = static_cast<std::uint32_t>(std::size(MeshVertexAttributes));
+
+    std::copy(std::begin(MeshVertexAttributes), std::end(MeshVertexAttributes), header.attributes);
+
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(-std::numeric_limits<float>::max());
+
+    for (const MeshVertex& vertex : mesh.vertices)
+    {
+        boundsMin = glm::min(boundsMin, vertex.position);
+        boundsMax = glm::max(boundsMax, vertex.position);
+    }
+
+    std::memcpy(header.boundsMin, &boundsMin, sizeof(header.boundsMin));
+    std::memcpy(header.boundsMax, &boundsMax, sizeof(header.boundsMax));
+
+    const std::uint64_t vertexSize = mesh.vertices.size() * sizeof(MeshVertex);
+    const std::uint64_t indexSize = mesh.indices.size() * sizeof(std::uint32_t);
+
+    header.vertexOffset = AlignBlobOffset(sizeof(MeshFileHeader));
+    header.indexOffset = AlignBlobOffset(header.vertexOffset + vertexSize);
+
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (!stream)
+    {
+        std::cerr << "Mesh file write error: " << path << "\n";
+        return false;
+    }
+
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    WritePadding(stream, sizeof(header), header.vertexOffset);
+
+    stream.write(reinterpret_cast<const char*>(mesh.vertices.data()), static_cast<std::streamsize>(vertexSize));
+    WritePadding(stream, header.vertexOffset + vertexSize, header.indexOffset);
+
+    stream.write(reinterpret_cast<const char*>(mesh.indices.data()), static_cast<std::streamsize>(indexSize));
+
+    if (!stream)
+    {
+        std::cerr << "Mesh file write error: " << path << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+bool MeshFile::Open(const std::string& path)
+{
+    Close();
+
+    if (!file.Open(path))
+        return false;
+
+    auto Fail = [&](const char* reason)
+    {
+        std::cerr << "Mesh file error (" << reason << "): " << path << "\n";
+        Close();
+        return false;
+    };
+
+    const std::size_t fileSize = file.GetSize();
+
+    if (fileSize < sizeof(MeshFileHeader))
+        return Fail("truncated header");
+
+    header = reinterpret_cast<const MeshFileHeader*>(file.GetData());
+
+    if (header->magic != MeshFileMagic)
+        return Fail("not a mesh file");
+
+    if (header->version != MeshFileVersion)
+        return Fail("unsupported version, reconvert the model");
+
+    if (header->attributeCount == 0 || header->attributeCount > MeshFileMaxAttributes ||
+        header->vertexStride == 0 || header->vertexStride > MeshFileMaxVertexStride)
+    {
+        return Fail("bad vertex layout");
+    }
+
+    std::uint32_t usedLocations = 0;
+
+    for (std::uint32_t i = 0; i < header->attributeCount; ++i)
+    {
+        const MeshFileAttribute& attribute = header->attributes[i];
+
+        if (attribute.componentCount == 0 || attribute.componentCount > 4 ||
+            attribute.offset + attribute.componentCount * sizeof(float) > header->vertexStride)
+        {
+            return Fail("bad vertex layout");
+        }
+
+        if (attribute.location >= MeshFileMaxLocations ||
+            (attribute.location >= MeshFileFirstInstanceLocation &&
+             attribute.location < MeshFileFirstInstanceLocation + MeshFileInstanceLocationCount))
+        {
+            return Fail("bad attribute location");
+        }
+
+        if (usedLocations & (1u << attribute.location))
+            return Fail("duplicate attribute location");
+
+        usedLocations |= 1u << attribute.location;
+    }
+
+    // a fejléc mezői nem megbízhatók: offset + size túlcsordulhat
+    auto FitsInFile = [&](std::uint64_t offset, std::uint64_t size)
+    {
+        return offset <= fileSize && size <= fileSize - offset;
+    };
+
+    const std::uint64_t vertexSize = static_cast<std::uint64_t>(header->vertexCount) * header->vertexStride;
+    const std::uint64_t indexSize = static_cast<std::uint64_t>(header->indexCount) * sizeof(std::uint32_t);
+
+    if (header->vertexOffset % MeshFileBlobAlignment != 0 || header->indexOffset % MeshFileBlobAlignment != 0 ||
+        header->vertexOffset < sizeof(MeshFileHeader) ||
+        !FitsInFile(header->vertexOffset, vertexSize) ||
+        !FitsInFile(header->indexOffset, indexSize))
+    {
+        return Fail("truncated data");
+    }
+
+    if (header->indexCount % 3 != 0)
+        return Fail("index count is not a triangle list");
+
+    // egy lineáris menet a leképezett indexeken; a feltöltés úgyis beolvassa őket
+    const std::uint32_t* indices = GetIndexData();
+    const std::uint32_t maxIndex = header->indexCount > 0 ? *std::max_element(indices, indices + header->indexCount) : 0;
+
+    if (header->indexCount > 0 && maxIndex >= header->vertexCount)
+        return Fail("index out of range");
+
+    return true;
+}
+
+void MeshFile::Close()
+{
+    file.Close();
+    header = nullptr;
+}
+
+const MeshFileHeader& MeshFile::GetHeader() const
+{
+    return *header;
+}
+
+AABB MeshFile::GetBounds() const
+{
+    return
+    {
+        glm::vec3(header->boundsMin[0], header->boundsMin[1], header->boundsMin[2]),
+        glm::vec3(header->boundsMax[0], header->boundsMax[1], header->boundsMax[2])
+    };
+}
+
+const std::byte* MeshFile::GetVertexData() const
+{
+    return file.GetData() + header->vertexOffset;
+}
+
+std::size_t MeshFile::GetVertexDataSize() const
+{
+    return static_cast<std::size_t>(header->vertexCount) * header->vertexStride;
+}
+
+const std::uint32_t* MeshFile::GetIndexData() const
+{
+    return reinterpret_cast<const std::uint32_t*>(file.GetData() + header->indexOffset);
+}
+
+std::size_t MeshFile::GetIndexCount() const
+{
+    return header->indexCount;
+}
\ No newline at end of file
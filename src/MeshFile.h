@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "AABB.h"
+#include "MappedFile.h"
+
+struct MeshData;
+
+// .zsm bináris mesh: fejléc, vertex layout leíró, bounds, majd a vertex és az
+// index blob 16 bájtos határra igazítva. Little-endian, a formátum változásakor
+// a MeshFileVersion nő (a régi fájlokat újra kell konvertálni).
+constexpr std::uint32_t MeshFileMagic = 0x4D535A; // "ZSM\0"
+constexpr std::uint32_t MeshFileVersion = 1;
+constexpr std::uint32_t MeshFileMaxAttributes = 8;
+constexpr std::size_t MeshFileBlobAlignment = 16;
+
+// Attribútum helyek: a GL_MAX_VERTEX_ATTRIBS garantált minimuma alatt, és nem
+// ütközhetnek a példányonkénti attribútumokkal (InstancedRenderer: mat4 + szín)
+constexpr std::uint32_t MeshFileMaxLocations = 16;
+constexpr std::uint32_t MeshFileFirstInstanceLocation = 2;
+constexpr std::uint32_t MeshFileInstanceLocationCount = 5;
+
+// a GL_MAX_VERTEX_ATTRIB_STRIDE garantált minimuma
+constexpr std::uint32_t MeshFileMaxVertexStride = 2048;
+
+// Egy vertex attribútum; minden komponens float
+struct MeshFileAttribute
+{
+    std::uint32_t location;        // a shader attribútum helye
+    std::uint32_t componentCount;  // 1-4
+    std::uint32_t offset;          // bájtban a vertex elejétől
+};
+
+struct MeshFileHeader
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+
+    std::uint32_t vertexCount;
+    std::uint32_t indexCount;     // 32 bites indexek, háromszöglista
+    std::uint32_t vertexStride;
+    std::uint32_t attributeCount;
+    MeshFileAttribute attributes[MeshFileMaxAttributes];
+
+    float boundsMin[3];
+    float boundsMax[3];
+
+    std::uint64_t vertexOffset;   // a fájl elejétől
+    std::uint64_t indexOffset;
+};
+
+static_assert(sizeof(MeshFileHeader) == 160, "a fejléc a fájlformátum része");
+
+// A MeshVertex (pozíció, szín) layoutja, a Mesh(MeshData) is ezt használja
+extern const MeshFileAttribute MeshVertexAttributes[2];
+
+// Az (optimalizált) adatot .zsm-ként írja ki; hibánál üzenetet ír és false-t ad
+bool WriteMeshFile(const std::string& path, const MeshData& mesh);
+
+// Leképezett .zsm fájl. A blobok közvetlenül a leképezésre mutatnak, így a
+// Mesh innen másolás nélkül tölt fel a GPU-ra. A fájl nem megbízható:
+// megnyitáskor a fejlécet, a layoutot, a blobok tartományát és minden
+// indexet ellenőriz, hogy hibás fájlból ne jusson a GPU-ra túlcímzés.
+class MeshFile
+{
+public:
+    bool Open(const std::string& path);
+    void Close();
+
+    const MeshFileHeader& GetHeader() const;
+    AABB GetBounds() const;
+
+    const std::byte* GetVertexData() const;
+    std::size_t GetVertexDataSize() const;
+
+    const std::uint32_t* GetIndexData() const;
+    std::size_t GetIndexCount() const;
+
+private:
+    MappedFile file;
+    const MeshFileHeader* header = nullptr;
+};
\ No newline at end of file
@@ -0,0 +1,392 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+#ifdef ENGINE_DEBUG
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#endif
+
+namespace
+{
+    // Forsyth pontozás paraméterei (az eredeti cikk értékei)
+    constexpr int ScoringCacheSize = 32;
+    constexpr float CacheDecayPower = 1.5f;
+    constexpr float LastTriangleScore = 0.75f;
+    constexpr float ValenceBoostScale = 2.0f;
+    constexpr float ValenceBoostPower = 0.5f;
+
+    constexpr std::uint32_t InvalidTriangle = std::numeric_limits<std::uint32_t>::max();
+
+    static_assert(sizeof(MeshVertex) == 6 * sizeof(float), "a deduplikálás bitenként hasonlít, nem lehet padding");
+
+    struct VertexBitsHash
+    {
+        std::size_t operator()(const MeshVertex& vertex) const
+        {
+            std::uint32_t words[6];
+            std::memcpy(words, &vertex, sizeof(words));
+
+            // FNV-1a a 6 szón
+            std::size_t hash = 2166136261u;
+            for (std::uint32_t word : words)
+            {
+                hash = (hash ^ word) * 16777619u;
+            }
+
+            return hash;
+        }
+    };
+
+    struct VertexBitsEqual
+    {
+        bool operator()(const MeshVertex& a, const MeshVertex& b) const
+        {
+            return std::memcmp(&a, &b, sizeof(MeshVertex)) == 0;
+        }
+    };
+
+    // Magasabb pont: a vertex a cache elején van, vagy kevés háromszöge maradt
+    // (a magányos vertexeket hamar el kell fogyasztani, különben később drágák)
+    float ScoreVertex(int cachePosition, std::uint32_t remainingTriangles)
+    {
+        if (remainingTriangles == 0)
+            return -1.0f;
+
+        float score = 0.0f;
+
+        if (cachePosition >= 0)
+        {
+            if (cachePosition < 3)
+            {
+                // az utolsó háromszög vertexei: szándékosan kisebb pont, hogy
+                // ne ugyanazt az élt használjuk újra és újra
+                score = LastTriangleScore;
+            }
+            else
+            {
+                const float scale = 1.0f / (ScoringCacheSize - 3);
+                score = std::pow(1.0f - (cachePosition - 3) * scale, CacheDecayPower);
+            }
+        }
+
+        score += ValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -ValenceBoostPower);
+
+        return score;
+    }
+}
+
+void DeduplicateVertices(MeshData& mesh)
+{
+    std::unordered_map<MeshVertex, std::uint32_t, VertexBitsHash, VertexBitsEqual> lookup;
+    lookup.reserve(mesh.vertices.size());
+
+    std::vector<MeshVertex> unique;
+    std::vector<std::uint32_t> remap(mesh.vertices.size());
+
+    for (std::size_t i = 0; i < mesh.vertices.size(); ++i)
+    {
+        auto [it, inserted] = lookup.try_emplace(mesh.vertices[i], static_cast<std::uint32_t>(unique.size()));
+
+        if (inserted)
+            unique.push_back(mesh.vertices[i]);
+
+        remap[i] = it->second;
+    }
+
+    for (std::uint32_t& index : mesh.indices)
+    {
+        index = remap[index];
+    }
+
+    mesh.vertices = std::move(unique);
+}
+
+void OptimizeVertexCache(MeshData& mesh)
+{
+    const std::size_t triangleCount = mesh.GetTriangleCount();
+    const std::size_t vertexCount = mesh.vertices.size();
+
+    if (triangleCount == 0)
+        return;
+
+    const std::vector<std::uint32_t>& indices = mesh.indices;
+
+    // vertex -> háromszögei, tömören (CSR). Egy vertex aktív háromszögei a
+    // saját tartományának elején vannak, a kiírtakat a végére cseréljük.
+    std::vector<std::uint32_t> triangleOffsets(vertexCount + 1, 0);
+    for (std::uint32_t index : indices)
+    {
+        ++triangleOffsets[index + 1];
+    }
+
+    for (std::size_t v = 0; v < vertexCount; ++v)
+    {
+        triangleOffsets[v + 1] += triangleOffsets[v];
+    }
+
+    std::vector<std::uint32_t> vertexTriangles(indices.size());
+    std::vector<std::uint32_t> remaining(vertexCount, 0);
+
+    for (std::size_t t = 0; t < triangleCount; ++t)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            const std::uint32_t v = indices[t * 3 + k];
+            vertexTriangles[triangleOffsets[v] + remaining[v]++] = static_cast<std::uint32_t>(t);
+        }
+    }
+
+    std::vector<float> vertexScore(vertexCount);
+
+    for (std::size_t v = 0; v < vertexCount; ++v)
+    {
+        vertexScore[v] = ScoreVertex(-1, remaining[v]);
+    }
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<char> emitted(triangleCount, 0);
+
+    std::uint32_t bestTriangle = 0;
+
+    for (std::size_t t = 0; t < triangleCount; ++t)
+    {
+        triangleScore[t] =
+            vertexScore[indices[t * 3]] +
+            vertexScore[indices[t * 3 + 1]] +
+            vertexScore[indices[t * 3 + 2]];
+
+        if (triangleScore[t] > triangleScore[bestTriangle])
+            bestTriangle = static_cast<std::uint32_t>(t);
+    }
+
+    std::vector<std::uint32_t> cache;
+    std::vector<std::uint32_t> nextCache;
+    cache.reserve(ScoringCacheSize + 3);
+    nextCache.reserve(ScoringCacheSize + 3);
+
+    std::vector<std::uint32_t> result;
+    result.reserve(indices.size());
+
+    std::size_t scanCursor = 0;
+
+    for (std::size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+    {
+        // a cache-ben nincs jelölt: a következő kiíratlan háromszöggel folytatjuk
+        if (bestTriangle == InvalidTriangle)
+        {
+            while (emitted[scanCursor])
+                ++scanCursor;
+
+            bestTriangle = static_cast<std::uint32_t>(scanCursor);
+        }
+
+        emitted[bestTriangle] = 1;
+        nextCache.clear();
+
+        for (int k = 0; k < 3; ++k)
+        {
+            const std::uint32_t v = indices[bestTriangle * 3 + k];
+            result.push_back(v);
+
+            if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end())
+                nextCache.push_back(v);
+
+            // a háromszöget kivesszük a vertex aktív listájából
+            std::uint32_t* first = &vertexTriangles[triangleOffsets[v]];
+            std::uint32_t* last = first + remaining[v];
+            std::uint32_t* found = std::find(first, last, bestTriangle);
+
+            std::swap(*found, *(last - 1));
+            --remaining[v];
+        }
+
+        // az új háromszög vertexei előre kerülnek, a többi hátrébb csúszik
+        const std::size_t triangleVertexCount = nextCache.size();
+
+        for (std::uint32_t v : cache)
+        {
+            auto triangleEnd = nextCache.begin() + triangleVertexCount;
+
+            if (std::find(nextCache.begin(), triangleEnd, v) == triangleEnd)
+                nextCache.push_back(v);
+        }
+
+        cache.swap(nextCache);
+
+        // pontszám frissítés: a cache-ben maradtak és a kiesők is változnak
+        for (std::size_t i = 0; i < cache.size(); ++i)
+        {
+            const std::uint32_t v = cache[i];
+            const int position = i < ScoringCacheSize ? static_cast<int>(i) : -1;
+
+            const float score = ScoreVertex(position, remaining[v]);
+            const float delta = score - vertexScore[v];
+            vertexScore[v] = score;
+
+            const std::uint32_t* first = &vertexTriangles[triangleOffsets[v]];
+            for (std::uint32_t j = 0; j < remaining[v]; ++j)
+            {
+                triangleScore[first[j]] += delta;
+            }
+        }
+
+        if (cache.size() > ScoringCacheSize)
+            cache.resize(ScoringCacheSize);
+
+        // a következő háromszöget csak a cache vertexeinek háromszögei közül választjuk
+        bestTriangle = InvalidTriangle;
+        float bestScore = -1.0f;
+
+        for (std::uint32_t v : cache)
+        {
+            const std::uint32_t* first = &vertexTriangles[triangleOffsets[v]];
+            for (std::uint32_t j = 0; j < remaining[v]; ++j)
+            {
+                if (triangleScore[first[j]] > bestScore)
+                {
+                    bestScore = triangleScore[first[j]];
+                    bestTriangle = first[j];
+                }
+            }
+        }
+    }
+
+    mesh.indices = std::move(result);
+}
+
+void OptimizeVertexFetch(MeshData& mesh)
+{
+    constexpr std::uint32_t Unused = std::numeric_limits<std::uint32_t>::max();
+
+    std::vector<std::uint32_t> remap(mesh.vertices.size(), Unused);
+    std::vector<MeshVertex> ordered;
+    ordered.reserve(mesh.vertices.size());
+
+    for (std::uint32_t& index : mesh.indices)
+    {
+        if (remap[index] == Unused)
+        {
+            remap[index] = static_cast<std::uint32_t>(ordered.size());
+            ordered.push_back(mesh.vertices[index]);
+        }
+
+        index = remap[index];
+    }
+
+    mesh.vertices = std::move(ordered);
+}
+
+void OptimizeMesh(MeshData& mesh)
+{
+    DeduplicateVertices(mesh);
+    OptimizeVertexCache(mesh);
+    OptimizeVertexFetch(mesh);
+}
+
+VertexCacheStats AnalyzeVertexCache(const std::vector<std::uint32_t>& indices, std::size_t vertexCount, int cacheSize)
+{
+    VertexCacheStats stats;
+
+    if (indices.empty())
+        return stats;
+
+    // FIFO: a vertex addig van bent, amíg utána legfeljebb cacheSize új vertex jött
+    std::vector<std::uint32_t> insertedAt(vertexCount, 0);
+    std::vector<char> used(vertexCount, 0);
+
+    std::uint32_t timestamp = static_cast<std::uint32_t>(cacheSize) + 1;
+    std::size_t misses = 0;
+    std::size_t usedCount = 0;
+
+    for (std::uint32_t index : indices)
+    {
+        if (timestamp - insertedAt[index] > static_cast<std::uint32_t>(cacheSize))
+        {
+            insertedAt[index] = timestamp++;
+            ++misses;
+        }
+
+        if (!used[index])
+        {
+            used[index] = 1;
+            ++usedCount;
+        }
+    }
+
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+    stats.atvr = static_cast<float>(misses) / static_cast<float>(usedCount);
+
+    return stats;
+}
+
+
+#ifdef ENGINE_DEBUG
+
+namespace
+{
+    void ReportMesh(const std::string& name, const MeshData& source)
+    {
+        VertexCacheStats before = AnalyzeVertexCache(source.indices, source.vertices.size());
+
+        MeshData deduplicated = source;
+        DeduplicateVertices(deduplicated);
+        const VertexCacheStats indexed = AnalyzeVertexCache(deduplicated.indices, deduplicated.vertices.size());
+
+        MeshData optimized = source;
+
+        auto start = std::chrono::steady_clock::now();
+        OptimizeMesh(optimized);
+        auto end = std::chrono::steady_clock::now();
+
+        const VertexCacheStats after = AnalyzeVertexCache(optimized.indices, optimized.vertices.size());
+
+        // az indexeletlen forrásban minden sarok külön vertex (ATVR = 1), ezért
+        // mindhárom oszlopot a tényleges egyedi vertexszámhoz viszonyítjuk
+        const float uniqueVertexCount = static_cast<float>(optimized.vertices.size());
+        const float triangleCount = static_cast<float>(source.GetTriangleCount());
+
+        before.atvr = before.acmr * triangleCount / uniqueVertexCount;
+
+        std::cout
+            << "  " << name << ": " << source.GetTriangleCount() << " tris, "
+            << source.vertices.size() << " -> " << optimized.vertices.size() << " vertices, "
+            << "ACMR " << before.acmr << " -> " << indexed.acmr << " -> " << after.acmr << ", "
+            << "ATVR " << before.atvr << " -> " << indexed.atvr << " -> " << after.atvr << ", "
+            << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+    }
+}
+
+void RunMeshOptimizationReport(const char* modelDirectory)
+{
+    std::cout << "Mesh optimization (cache " << VertexCacheSize << ", raw -> deduplicated -> optimized)\n";
+
+    ReportMesh("cube", MakeCubeMeshData());
+    ReportMesh("zombie capsule", MakeCapsuleMeshData(0.3f, 1.8f, 24, 12, glm::vec3(0.3f, 0.5f, 0.3f)));
+
+    std::error_code error;
+    std::filesystem::directory_iterator directory(modelDirectory, error);
+
+    if (error)
+    {
+        std::cout << "  no models in " << modelDirectory << "\n";
+        return;
+    }
+
+    for (const std::filesystem::directory_entry& entry : directory)
+    {
+        if (entry.path().extension() != ".obj")
+            continue;
+
+        MeshData model;
+        if (LoadObjMesh(entry.path().string(), glm::vec3(1.0f), model))
+            ReportMesh(entry.path().filename().string(), model);
+    }
+}
+
+#endif
\ No newline at end of file
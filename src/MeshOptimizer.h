@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "MeshData.h"
+
+// A GPU post-transform vertex cache méretének becslése; a mai kártyák
+// gyakorlatilag 16-32 bejegyzéses FIFO-ként viselkednek
+constexpr int VertexCacheSize = 16;
+
+struct VertexCacheStats
+{
+    float acmr = 0.0f; // average cache miss ratio: transzformált vertex / háromszög (0.5 - 3.0)
+    float atvr = 0.0f; // average transformed vertex ratio: transzformált / egyedi vertex (1.0-tól)
+};
+
+// A bitre azonos vertexeket összevonja, az indexeket átírja
+void DeduplicateVertices(MeshData& mesh);
+
+// Háromszög sorrend a vertex cache-hez (Forsyth: lineáris idejű, pontozásos mohó algoritmus)
+void OptimizeVertexCache(MeshData& mesh);
+
+// A vertexeket első használatuk sorrendjébe rendezi, a nem használtakat eldobja
+void OptimizeVertexFetch(MeshData& mesh);
+
+// Mindhárom lépés a helyes sorrendben (betöltéskor ezt hívjuk)
+void OptimizeMesh(MeshData& mesh);
+
+// FIFO cache szimuláció az index bufferen
+VertexCacheStats AnalyzeVertexCache(const std::vector<std::uint32_t>& indices, std::size_t vertexCount, int cacheSize = VertexCacheSize);
+
+#ifdef ENGINE_DEBUG
+
+// ACMR/ATVR optimalizálás előtt és után a beépített meshekre és a
+// modelDirectory összes .obj fájljára. Az eredményt a konzolra írja.
+void RunMeshOptimizationReport(const char* modelDirectory);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "OBB.h"
+#include "Entity.h"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+OBB ComputeWorldOBB(const Entity& entity)
+{
+    const CollisionShape& c = entity.collision;
+    const glm::mat3 rotation = entity.transform.GetRotationMatrix();
+
+    OBB box;
+    box.center = entity.transform.position + rotation * c.localOffset;
+    box.axes[0] = rotation[0];
+    box.axes[1] = rotation[1];
+    box.axes[2] = rotation[2];
+    box.halfExtents = c.halfExtents;
+
+    return box;
+}
+
+const OBB& GetWorldOBB(const Entity& entity)
+{
+    if (entity.worldOBBDirty)
+    {
+        entity.cachedWorldOBB = ComputeWorldOBB(entity);
+        entity.worldOBBDirty = false;
+    }
+
+    return entity.cachedWorldOBB;
+}
+
+AABB ComputeOBBBounds(const OBB& box)
+{
+    // a befoglaló doboz fél mérete tengelyenként: sum |axis_i| * h_i
+    glm::vec3 extents =
+        glm::abs(box.axes[0]) * box.halfExtents.x +
+        glm::abs(box.axes[1]) * box.halfExtents.y +
+        glm::abs(box.axes[2]) * box.halfExtents.z;
+
+    return { box.center - extents, box.center + extents };
+}
+
+glm::vec3 ToOBBLocalPoint(const OBB& box, const glm::vec3& point)
+{
+    return ToOBBLocalDirection(box, point - box.center);
+}
+
+glm::vec3 ToOBBLocalDirection(const OBB& box, const glm::vec3& direction)
+{
+    return
+    {
+        glm::dot(direction, box.axes[0]),
+        glm::dot(direction, box.axes[1]),
+        glm::dot(direction, box.axes[2])
+    };
+}
+
+glm::vec3 FromOBBLocalDirection(const OBB& box, const glm::vec3& direction)
+{
+    return box.axes[0] * direction.x + box.axes[1] * direction.y + box.axes[2] * direction.z;
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+#include "AABB.h"
+
+struct Entity;
+
+// Orientált doboz. Az axes a forgatott helyi tengelyek (egységvektorok),
+// transform változásakor egyszer számoljuk ki, a tesztek ezt használják.
+struct OBB
+{
+    glm::vec3 center;
+    glm::vec3 axes[3];
+    glm::vec3 halfExtents;
+};
+
+// Mindig újraszámol a Transform forgatása és a CollisionShape alapján
+OBB ComputeWorldOBB(const Entity& entity);
+
+// Gyorsítótárazott változat, a GetWorldAABB-vel együtt MarkTransformDirty érvényteleníti
+const OBB& GetWorldOBB(const Entity& entity);
+
+// Az OBB-t befoglaló (konzervatív) AABB, ez kerül a broadphase-be
+AABB ComputeOBBBounds(const OBB& box);
+
+// Átváltás az OBB helyi koordinátarendszerébe és vissza
+glm::vec3 ToOBBLocalPoint(const OBB& box, const glm::vec3& point);
+glm::vec3 ToOBBLocalDirection(const OBB& box, const glm::vec3& direction);
+glm::vec3 FromOBBLocalDirection(const OBB& box, const glm::vec3& direction);
\ No newline at end of file
@@ -0,0 +1,421 @@
+#include "OcclusionCulling.h"
+#include "CollisionBatch.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Az occludee legközelebbi mélységéből ennyit vonunk le (1 közelében kb.
+    // 16 ulp): a saját occluderként is beírt lap a kerekítés miatt se takarja el
+    constexpr float OccludeeDepthBias = 1e-6f;
+
+    // a doboz 12 háromszöge a sarkok indexével (bit 0: x, bit 1: y, bit 2: z)
+    constexpr int BoxTriangles[12][3] =
+    {
+        { 0, 2, 3 }, { 0, 3, 1 }, // -z
+        { 4, 5, 7 }, { 4, 7, 6 }, // +z
+        { 0, 4, 6 }, { 0, 6, 2 }, // -x
+        { 1, 3, 7 }, { 1, 7, 5 }, // +x
+        { 0, 1, 5 }, { 0, 5, 4 }, // -y
+        { 2, 6, 7 }, { 2, 7, 3 }  // +y
+    };
+
+    glm::vec3 BoxCorner(const AABB& box, int corner)
+    {
+        return
+        {
+            (corner & 1) ? box.max.x : box.min.x,
+            (corner & 2) ? box.max.y : box.min.y,
+            (corner & 4) ? box.max.z : box.min.z
+        };
+    }
+
+    // OpenGL közeli sík: z + w >= 0
+    float NearDistance(const glm::vec4& clip)
+    {
+        return clip.z + clip.w;
+    }
+
+    struct EdgeSetup
+    {
+        float a[3];
+        float b[3];
+        float c[3];
+
+        // mélység = z0 + dzdx * x + dzdy * y
+        float z0;
+        float dzdx;
+        float dzdy;
+    };
+
+    bool SetupTriangle(glm::vec3 v0, glm::vec3 v1, glm::vec3 v2, EdgeSetup& setup)
+    {
+        float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+
+        if (std::abs(area) < 1e-6f)
+            return false;
+
+        // egységes körüljárás, így a belső pontokon mindhárom élfüggvény >= 0
+        if (area < 0.0f)
+        {
+            std::swap(v1, v2);
+            area = -area;
+        }
+
+        const glm::vec3 vertices[3] = { v0, v1, v2 };
+
+        for (int edge = 0; edge < 3; ++edge)
+        {
+            const glm::vec3& from = vertices[(edge + 1) % 3];
+            const glm::vec3& to = vertices[(edge + 2) % 3];
+
+            setup.a[edge] = from.y - to.y;
+            setup.b[edge] = to.x - from.x;
+            setup.c[edge] = from.x * to.y - from.y * to.x;
+        }
+
+        // a mélység a képernyőn lineáris (z / w), a baricentrikus súlyokból
+        const float inverseArea = 1.0f / area;
+
+        setup.dzdx = (setup.a[0] * v0.z + setup.a[1] * v1.z + setup.a[2] * v2.z) * inverseArea;
+        setup.dzdy = (setup.b[0] * v0.z + setup.b[1] * v1.z + setup.b[2] * v2.z) * inverseArea;
+        // a v0-hoz rögzített alak: a kamera felé néző lapon (dzdx, dzdy ~ 0) a
+        // mélység pontosan a csúcsoké marad, nem nagy tagok különbsége
+        setup.z0 = v0.z - setup.dzdx * v0.x - setup.dzdy * v0.y;
+
+        return true;
+    }
+
+    void RasterizeSpanScalar(const EdgeSetup& setup, float* depthRow, int y, int x0, int x1)
+    {
+        const float py = static_cast<float>(y) + 0.5f;
+
+        for (int x = x0; x < x1; ++x)
+        {
+            const float px = static_cast<float>(x) + 0.5f;
+
+            if (setup.a[0] * px + setup.b[0] * py + setup.c[0] < 0.0f ||
+                setup.a[1] * px + setup.b[1] * py + setup.c[1] < 0.0f ||
+                setup.a[2] * px + setup.b[2] * py + setup.c[2] < 0.0f)
+            {
+                continue;
+            }
+
+            const float z = setup.z0 + setup.dzdx * px + setup.dzdy * py;
+            depthRow[x] = std::min(depthRow[x], z);
+        }
+    }
+
+#ifdef ZS_SIMD_X86
+
+    // 4 pixel egyszerre; x0 és x1 4-gyel osztható, és a csempén belül van
+    ZS_TARGET_SSE2 void RasterizeSpanSSE(const EdgeSetup& setup, float* depthRow, int y, int x0, int x1)
+    {
+        const __m128 py = _mm_set1_ps(static_cast<float>(y) + 0.5f);
+        const __m128 laneOffset = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+        const __m128 zero = _mm_setzero_ps();
+
+        __m128 a[3];
+        __m128 rowBase[3];
+
+        for (int edge = 0; edge < 3; ++edge)
+        {
+            a[edge] = _mm_set1_ps(setup.a[edge]);
+            rowBase[edge] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(setup.b[edge]), py), _mm_set1_ps(setup.c[edge]));
+        }
+
+        const __m128 dzdx = _mm_set1_ps(setup.dzdx);
+        const __m128 depthBase = _mm_add_ps(_mm_set1_ps(setup.z0), _mm_mul_ps(_mm_set1_ps(setup.dzdy), py));
+
+        for (int x = x0; x < x1; x += 4)
+        {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffset);
+
+            __m128 e0 = _mm_add_ps(_mm_mul_ps(a[0], px), rowBase[0]);
+            __m128 e1 = _mm_add_ps(_mm_mul_ps(a[1], px), rowBase[1]);
+            __m128 e2 = _mm_add_ps(_mm_mul_ps(a[2], px), rowBase[2]);
+
+            __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+
+            if (_mm_movemask_ps(inside) == 0)
+                continue;
+
+            __m128 z = _mm_add_ps(depthBase, _mm_mul_ps(dzdx, px));
+            __m128 old = _mm_loadu_ps(depthRow + x);
+            __m128 closer = _mm_min_ps(old, z);
+
+            // a háromszögön kívüli sávok a régi értéket tartják meg
+            _mm_storeu_ps(depthRow + x, _mm_or_ps(_mm_and_ps(inside, closer), _mm_andnot_ps(inside, old)));
+        }
+    }
+
+#endif
+}
+
+OcclusionBuffer::OcclusionBuffer(JobSystem& jobs)
+    : jobs(jobs),
+    depth(Width * Height, 1.0f)
+{
+    std::fill(std::begin(tileMaxDepth), std::end(tileMaxDepth), 1.0f);
+}
+
+void OcclusionBuffer::Begin(const glm::mat4& newViewProjection)
+{
+    viewProjection = newViewProjection;
+
+    triangles.clear();
+
+    for (std::vector<std::uint32_t>& bin : tileBins)
+    {
+        bin.clear();
+    }
+}
+
+void OcclusionBuffer::AddOccluder(const AABB& box)
+{
+    glm::vec4 clip[8];
+
+    for (int corner = 0; corner < 8; ++corner)
+    {
+        clip[corner] = viewProjection * glm::vec4(BoxCorner(box, corner), 1.0f);
+    }
+
+    for (const auto& triangle : BoxTriangles)
+    {
+        AddClippedTriangle(clip[triangle[0]], clip[triangle[1]], clip[triangle[2]]);
+    }
+}
+
+void OcclusionBuffer::AddClippedTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c)
+{
+    const glm::vec4 input[3] = { a, b, c };
+    const float distances[3] = { NearDistance(a), NearDistance(b), NearDistance(c) };
+
+    if (distances[0] >= 0.0f && distances[1] >= 0.0f && distances[2] >= 0.0f)
+    {
+        AddScreenTriangle(a, b, c);
+        return;
+    }
+
+    // Sutherland-Hodgman a közeli síkra: legfeljebb négyszög marad
+    glm::vec4 output[4];
+    int outputCount = 0;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        const int next = (i + 1) % 3;
+
+        if (distances[i] >= 0.0f)
+            output[outputCount++] = input[i];
+
+        if ((distances[i] >= 0.0f) != (distances[next] >= 0.0f))
+        {
+            const float t = distances[i] / (distances[i] - distances[next]);
+            output[outputCount++] = input[i] + (input[next] - input[i]) * t;
+        }
+    }
+
+    for (int i = 1; i + 1 < outputCount; ++i)
+    {
+        AddScreenTriangle(output[0], output[i], output[i + 1]);
+    }
+}
+
+void OcclusionBuffer::AddScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c)
+{
+    auto ToScreen = [](const glm::vec4& clip)
+    {
+        const float inverseW = 1.0f / clip.w;
+
+        return glm::vec3(
+            (clip.x * inverseW * 0.5f + 0.5f) * Width,
+            (clip.y * inverseW * 0.5f + 0.5f) * Height,
+            clip.z * inverseW * 0.5f + 0.5f);
+    };
+
+    ScreenTriangle triangle = { ToScreen(a), ToScreen(b), ToScreen(c) };
+
+    const float minX = std::min({ triangle.v0.x, triangle.v1.x, triangle.v2.x });
+    const float maxX = std::max({ triangle.v0.x, triangle.v1.x, triangle.v2.x });
+    const float minY = std::min({ triangle.v0.y, triangle.v1.y, triangle.v2.y });
+    const float maxY = std::max({ triangle.v0.y, triangle.v1.y, triangle.v2.y });
+
+    if (maxX < 0.0f || maxY < 0.0f || minX >= Width || minY >= Height)
+        return;
+
+    const int tileMinX = std::clamp(static_cast<int>(minX) / TileWidth, 0, TilesX - 1);
+    const int tileMaxX = std::clamp(static_cast<int>(maxX) / TileWidth, 0, TilesX - 1);
+    const int tileMinY = std::clamp(static_cast<int>(minY) / TileHeight, 0, TilesY - 1);
+    const int tileMaxY = std::clamp(static_cast<int>(maxY) / TileHeight, 0, TilesY - 1);
+
+    const std::uint32_t index = static_cast<std::uint32_t>(triangles.size());
+    triangles.push_back(triangle);
+
+    for (int ty = tileMinY; ty <= tileMaxY; ++ty)
+    {
+        for (int tx = tileMinX; tx <= tileMaxX; ++tx)
+        {
+            tileBins[ty * TilesX + tx].push_back(index);
+        }
+    }
+}
+
+void OcclusionBuffer::Rasterize()
+{
+    constexpr int TileCount = TilesX * TilesY;
+
+    // a csempék függetlenek, csempénként egy job
+    jobs.ParallelFor(TileCount, 1, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t tile = first; tile < last; ++tile)
+        {
+            RasterizeTile(static_cast<int>(tile));
+        }
+    });
+}
+
+void OcclusionBuffer::RasterizeTile(int tileIndex)
+{
+    const int tileMinX = (tileIndex % TilesX) * TileWidth;
+    const int tileMinY = (tileIndex / TilesX) * TileHeight;
+
+    for (int y = tileMinY; y < tileMinY + TileHeight; ++y)
+    {
+        std::fill_n(depth.begin() + y * Width + tileMinX, TileWidth, 1.0f);
+    }
+
+    for (std::uint32_t triangle : tileBins[tileIndex])
+    {
+        RasterizeTriangle(triangles[triangle], tileMinX, tileMinY);
+    }
+
+    float maxDepth = 0.0f;
+
+    for (int y = tileMinY; y < tileMinY + TileHeight; ++y)
+    {
+        const float* row = depth.data() + y * Width;
+        maxDepth = std::max(maxDepth, *std::max_element(row + tileMinX, row + tileMinX + TileWidth));
+    }
+
+    tileMaxDepth[tileIndex] = maxDepth;
+}
+
+void OcclusionBuffer::RasterizeTriangle(const ScreenTriangle& triangle, int tileMinX, int tileMinY)
+{
+    EdgeSetup setup;
+    if (!SetupTriangle(triangle.v0, triangle.v1, triangle.v2, setup))
+        return;
+
+    const float minX = std::min({ triangle.v0.x, triangle.v1.x, triangle.v2.x });
+    const float maxX = std::max({ triangle.v0.x, triangle.v1.x, triangle.v2.x });
+    const float minY = std::min({ triangle.v0.y, triangle.v1.y, triangle.v2.y });
+    const float maxY = std::max({ triangle.v0.y, triangle.v1.y, triangle.v2.y });
+
+    // a befoglaló téglalap a csempére vágva, x 4-es határokra igazítva
+    const int x0 = std::max(tileMinX, static_cast<int>(std::floor(minX)) & ~3);
+    const int x1 = std::min(tileMinX + TileWidth, (static_cast<int>(std::ceil(maxX)) + 3) & ~3);
+    const int y0 = std::max(tileMinY, static_cast<int>(std::floor(minY)));
+    const int y1 = std::min(tileMinY + TileHeight, static_cast<int>(std::ceil(maxY)));
+
+#ifdef ZS_SIMD_X86
+    const bool useSse = GetSimdLevel() != SimdLevel::Scalar;
+#endif
+
+    for (int y = y0; y < y1; ++y)
+    {
+        float* row = depth.data() + y * Width;
+
+#ifdef ZS_SIMD_X86
+        if (useSse)
+        {
+            RasterizeSpanSSE(setup, row, y, x0, x1);
+            continue;
+        }
+#endif
+
+        RasterizeSpanScalar(setup, row, y, x0, x1);
+    }
+}
+
+bool OcclusionBuffer::IsVisible(const AABB& box) const
+{
+    float minX = 1.0f;
+    float maxX = -1.0f;
+    float minY = 1.0f;
+    float maxY = -1.0f;
+    float minDepth = 1.0f;
+
+    for (int corner = 0; corner < 8; ++corner)
+    {
+        const glm::vec4 clip = viewProjection * glm::vec4(BoxCorner(box, corner), 1.0f);
+
+        // a doboz a közeli síkot metszi: nem tudjuk vetíteni
+        if (clip.w <= 1e-4f || NearDistance(clip) < 0.0f)
+            return true;
+
+        const float inverseW = 1.0f / clip.w;
+
+        if (corner == 0)
+        {
+            minX = maxX = clip.x * inverseW;
+            minY = maxY = clip.y * inverseW;
+        }
+        else
+        {
+            minX = std::min(minX, clip.x * inverseW);
+            maxX = std::max(maxX, clip.x * inverseW);
+            minY = std::min(minY, clip.y * inverseW);
+            maxY = std::max(maxY, clip.y * inverseW);
+        }
+
+        minDepth = std::min(minDepth, clip.z * inverseW * 0.5f + 0.5f);
+    }
+
+    // Konzervatív lefedés: minden pixel, amelyet a téglalap érint, egy pixel
+    // ráhagyással, mert az occluderek a pixelközéppel mintavételezve a
+    // részben fedett szélső pixeleket is teljesen takartnak írják
+    const int px0 = std::max(0, static_cast<int>(std::floor((minX * 0.5f + 0.5f) * Width)) - 1);
+    const int px1 = std::min(Width - 1, static_cast<int>(std::floor((maxX * 0.5f + 0.5f) * Width)) + 1);
+    const int py0 = std::max(0, static_cast<int>(std::floor((minY * 0.5f + 0.5f) * Height)) - 1);
+    const int py1 = std::min(Height - 1, static_cast<int>(std::floor((maxY * 0.5f + 0.5f) * Height)) + 1);
+
+    minDepth -= OccludeeDepthBias;
+
+    if (px0 > px1 || py0 > py1)
+        return true;
+
+    for (int ty = py0 / TileHeight; ty <= py1 / TileHeight; ++ty)
+    {
+        for (int tx = px0 / TileWidth; tx <= px1 / TileWidth; ++tx)
+        {
+            // az egész csempe közelebb van: a doboz ezen a részén biztosan takart
+            if (tileMaxDepth[ty * TilesX + tx] < minDepth)
+                continue;
+
+            const int x0 = std::max(px0, tx * TileWidth);
+            const int x1 = std::min(px1, tx * TileWidth + TileWidth - 1);
+            const int y0 = std::max(py0, ty * TileHeight);
+            const int y1 = std::min(py1, ty * TileHeight + TileHeight - 1);
+
+            for (int y = y0; y <= y1; ++y)
+            {
+                const float* row = depth.data() + y * Width;
+
+                for (int x = x0; x <= x1; ++x)
+                {
+                    if (row[x] >= minDepth)
+                        return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+int OcclusionBuffer::GetTriangleCount() const
+{
+    return static_cast<int>(triangles.size());
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include "AABB.h"
+#include "JobSystem.h"
+
+// Kis felbontású CPU mélységbuffer a takarás vizsgálatához. Az occluder dobozokat
+// (statikus falak, barikádok) csempékre bontva, több szálon raszterizálja, majd a
+// kirajzolás előtt az entitások dobozait ehhez méri. Minden döntés konzervatív:
+// kétes esetben (közeli sík mögötti csúcs, képen kívüli doboz) láthatónak számít.
+class OcclusionBuffer
+{
+public:
+    static constexpr int Width = 256;
+    static constexpr int Height = 128;
+    static constexpr int TileWidth = 64;
+    static constexpr int TileHeight = 32;
+    static constexpr int TilesX = Width / TileWidth;
+    static constexpr int TilesY = Height / TileHeight;
+
+    // a csempéket a job rendszer szálai raszterizálják
+    explicit OcclusionBuffer(JobSystem& jobs);
+
+    // Új képkocka: törli a mélységet és az occludereket
+    void Begin(const glm::mat4& viewProjection);
+
+    void AddOccluder(const AABB& box);
+
+    // Csempénként párhuzamosan raszterizál, és kiszámolja a csempék legnagyobb mélységét
+    void Rasterize();
+
+    // false, ha a dobozt biztosan eltakarják az occluderek
+    bool IsVisible(const AABB& box) const;
+
+    int GetTriangleCount() const;
+
+private:
+    struct ScreenTriangle
+    {
+        glm::vec3 v0;
+        glm::vec3 v1;
+        glm::vec3 v2; // x, y pixelben, z mélység [0, 1]
+    };
+
+    void AddClippedTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+    void AddScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+
+    void RasterizeTile(int tileIndex);
+    void RasterizeTriangle(const ScreenTriangle& triangle, int tileMinX, int tileMinY);
+
+private:
+    JobSystem& jobs;
+
+    glm::mat4 viewProjection{ 1.0f };
+
+    std::vector<float> depth;
+    float tileMaxDepth[TilesX * TilesY];
+
+    std::vector<ScreenTriangle> triangles;
+    std::vector<std::uint32_t> tileBins[TilesX * TilesY];
+};
\ No newline at end of file
@@ -0,0 +1,352 @@
+#include "RenderQueue.h"
+#include "GpuDrivenRenderer.h"
+#include "Shader.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+
+namespace
+{
+    // egy darab legalább ennyi elem, különben a job kezelése többe kerül
+    constexpr std::size_t MinBuildChunkSize = 256;
+
+    // a SortEntry::packet felső bitjei a lista, az alsók a listán belüli index
+    constexpr int PacketIndexBits = 24;
+    constexpr std::uint32_t PacketIndexMask = (1u << PacketIndexBits) - 1;
+
+    static_assert(JobSystem::MaxThreadCount <= (1 << (32 - PacketIndexBits)));
+
+    constexpr int StateShift = SortKeyDepthBits;
+    constexpr int MaterialShift = SortKeyDepthBits;
+    constexpr int MeshShift = MaterialShift + SortKeyMaterialBits;
+    constexpr int ShaderShift = MeshShift + SortKeyMeshBits;
+    constexpr int PassShift = ShaderShift + SortKeyShaderBits;
+
+    constexpr std::uint64_t FieldMask(int bits)
+    {
+        return (std::uint64_t{ 1 } << bits) - 1;
+    }
+}
+
+std::uint64_t MakeSortKey(RenderPass pass, std::uint32_t shaderId, std::uint32_t meshId, std::uint32_t material, float normalizedDepth)
+{
+    const float clampedDepth = std::clamp(normalizedDepth, 0.0f, 1.0f);
+    const std::uint64_t depth = static_cast<std::uint64_t>(clampedDepth * static_cast<float>(FieldMask(SortKeyDepthBits)));
+
+    return
+        ((static_cast<std::uint64_t>(pass) & FieldMask(SortKeyPassBits)) << PassShift) |
+        ((static_cast<std::uint64_t>(shaderId) & FieldMask(SortKeyShaderBits)) << ShaderShift) |
+        ((static_cast<std::uint64_t>(meshId) & FieldMask(SortKeyMeshBits)) << MeshShift) |
+        ((static_cast<std::uint64_t>(material) & FieldMask(SortKeyMaterialBits)) << MaterialShift) |
+        depth;
+}
+
+RenderCommandList::RenderCommandList(LinearArena& arena)
+    : packets(ArenaAllocator<RenderPacket>(arena))
+{
+}
+
+void RenderCommandList::Add(std::uint64_t sortKey, const glm::mat4& model, const glm::vec3& color, bool useVertexColor)
+{
+    packets.push_back({ sortKey, { model, glm::vec4(color, useVertexColor ? 1.0f : 0.0f) } });
+}
+
+RenderQueue::RenderQueue(JobSystem& jobs, FrameArena& frameArena)
+    : jobs(jobs),
+    frameArena(frameArena)
+{
+    commandLists.reserve(jobs.GetThreadCount());
+
+    for (int thread = 0; thread < jobs.GetThreadCount(); ++thread)
+    {
+        commandLists.emplace_back(frameArena.GetArena(thread));
+    }
+}
+
+std::uint32_t RenderQueue::RegisterShader(const Shader& shader)
+{
+    // a túl nagy azonosító átlógna a szomszéd mezőbe, és összevonná a batcheket
+    if (shaders.size() > FieldMask(SortKeyShaderBits))
+    {
+        std::cerr << "Too many render queue shaders (max " << FieldMask(SortKeyShaderBits) + 1 << ")\n";
+        std::abort();
+    }
+
+    shaders.push_back(&shader);
+    return static_cast<std::uint32_t>(shaders.size() - 1);
+}
+
+std::uint32_t RenderQueue::RegisterMesh(const Mesh& mesh)
+{
+    if (meshes.size() > FieldMask(SortKeyMeshBits))
+    {
+        std::cerr << "Too many render queue meshes (max " << FieldMask(SortKeyMeshBits) + 1 << ")\n";
+        std::abort();
+    }
+
+    meshes.push_back(&mesh);
+    return static_cast<std::uint32_t>(meshes.size() - 1);
+}
+
+void RenderQueue::Begin()
+{
+    // a régi csomagok memóriáját az aréna adja vissza, itt csak elengedjük
+    for (RenderCommandList& commands : commandLists)
+    {
+        commands.reserveHint = commands.packets.size();
+        commands.packets = ArenaVector<RenderPacket>(commands.packets.get_allocator());
+    }
+
+    sortEntries = nullptr;
+    packetCount = 0;
+}
+
+void RenderQueue::Build(std::size_t itemCount, const BuildFunction& build)
+{
+    // a szálak csak a saját listájukba írnak
+    ForEachChunk(itemCount, [&](int thread, std::size_t first, std::size_t last)
+    {
+        RenderCommandList& commands = commandLists[thread];
+
+        // az első darab a szál saját arénájából foglal, az előző képkocka méretére
+        if (commands.packets.capacity() == 0)
+            commands.packets.reserve(commands.reserveHint);
+
+        build(first, last, commands);
+    });
+}
+
+void RenderQueue::ForEachChunk(std::size_t itemCount, const ChunkFunction& work)
+{
+    const int threadCount = jobs.GetThreadCount();
+    const std::size_t grainSize = std::max(MinBuildChunkSize, (itemCount + threadCount * 4 - 1) / (threadCount * 4));
+
+    // a darab a futtató szál listájába ír, így a listákhoz nem kell zár
+    jobs.ParallelFor(itemCount, grainSize, [&](std::size_t first, std::size_t last)
+    {
+        work(jobs.GetCurrentThreadIndex(), first, last);
+    });
+}
+
+std::size_t RenderQueue::CountPackets() const
+{
+    std::size_t count = 0;
+
+    for (const RenderCommandList& commands : commandLists)
+    {
+        count += commands.packets.size();
+    }
+
+    return count;
+}
+
+void RenderQueue::Sort()
+{
+    LinearArena& arena = frameArena.GetThreadArena();
+
+    packetCount = CountPackets();
+
+    // a rendezett tömb a képkocka végéig kell (Execute), a segédtömb csak itt
+    sortEntries = arena.AllocateArray<SortEntry>(packetCount);
+
+    if (packetCount == 0)
+        return;
+
+    // LSD radix rendezés 8 bites számjegyekkel. Az összes hisztogram egy
+    // olvasással készül, és a csak egy vödröt érintő számjegyeket (pl. a pass
+    // vagy a shader, ha mindenki ugyanazt használja) kihagyjuk.
+    constexpr int DigitBits = 8;
+    constexpr int DigitCount = 64 / DigitBits;
+    constexpr int BucketCount = 1 << DigitBits;
+
+    std::uint32_t histograms[DigitCount][BucketCount] = {};
+    std::uint64_t firstKey = 0;
+    bool hasFirstKey = false;
+
+    for (const RenderCommandList& commands : commandLists)
+    {
+        for (const RenderPacket& packet : commands.packets)
+        {
+            for (int digit = 0; digit < DigitCount; ++digit)
+            {
+                ++histograms[digit][(packet.sortKey >> (digit * DigitBits)) & (BucketCount - 1)];
+            }
+        }
+
+        if (!hasFirstKey && !commands.packets.empty())
+        {
+            firstKey = commands.packets.front().sortKey;
+            hasFirstKey = true;
+        }
+    }
+
+    bool sortDigit[DigitCount];
+    int passCount = 0;
+
+    for (int digit = 0; digit < DigitCount; ++digit)
+    {
+        sortDigit[digit] = histograms[digit][(firstKey >> (digit * DigitBits)) & (BucketCount - 1)] != packetCount;
+        passCount += sortDigit[digit] ? 1 : 0;
+    }
+
+    ScratchScope scratch(arena);
+    SortEntry* buffer = arena.AllocateArray<SortEntry>(packetCount);
+
+    // Páratlan számú menetnél a segédtömbből indulunk, így az eredmény
+    // másolás nélkül a sortEntries-be kerül
+    SortEntry* source = passCount % 2 == 0 ? sortEntries : buffer;
+    SortEntry* target = passCount % 2 == 0 ? buffer : sortEntries;
+
+    std::size_t index = 0;
+
+    for (std::size_t list = 0; list < commandLists.size(); ++list)
+    {
+        const ArenaVector<RenderPacket>& packets = commandLists[list].packets;
+
+        for (std::size_t i = 0; i < packets.size(); ++i)
+        {
+            source[index++] = { packets[i].sortKey, static_cast<std::uint32_t>((list << PacketIndexBits) | i) };
+        }
+    }
+
+    for (int digit = 0; digit < DigitCount; ++digit)
+    {
+        if (!sortDigit[digit])
+            continue;
+
+        std::uint32_t* histogram = histograms[digit];
+
+        std::uint32_t offset = 0;
+        for (int bucket = 0; bucket < BucketCount; ++bucket)
+        {
+            const std::uint32_t count = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += count;
+        }
+
+        for (std::size_t i = 0; i < packetCount; ++i)
+        {
+            const SortEntry& entry = source[i];
+            target[histogram[(entry.key >> (digit * DigitBits)) & (BucketCount - 1)]++] = entry;
+        }
+
+        std::swap(source, target);
+    }
+}
+
+void RenderQueue::Prepare(InstanceData* destination)
+{
+    Sort();
+
+    drawCallCount = 0;
+    shaderChangeCount = 0;
+
+    if (destination == nullptr)
+        return;
+
+    ForEachChunk(packetCount, [&](int, std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            const std::uint32_t packet = sortEntries[i].packet;
+            destination[i] = commandLists[packet >> PacketIndexBits].packets[packet & PacketIndexMask].instance;
+        }
+    });
+}
+
+void RenderQueue::Execute(InstancedRenderer& renderer)
+{
+    // betelt stream buffernél csak a statisztika készül el, nincs rajzolás
+    const StreamAllocation instances = renderer.AllocateInstances(CountPackets());
+    Prepare(reinterpret_cast<InstanceData*>(instances.data));
+
+    if (!instances.IsValid())
+        return;
+
+    const Shader* currentShader = nullptr;
+    std::size_t runStart = 0;
+
+    // az azonos állapotú (a mélységet leszámítva egyező kulcsú) csomagok egy rajzolás
+    for (std::size_t i = 1; i <= packetCount; ++i)
+    {
+        const std::uint64_t runState = sortEntries[runStart].key >> StateShift;
+
+        if (i < packetCount && (sortEntries[i].key >> StateShift) == runState)
+            continue;
+
+        const Shader* shader = shaders[(runState >> (ShaderShift - StateShift)) & FieldMask(SortKeyShaderBits)];
+        const Mesh* mesh = meshes[(runState >> (MeshShift - StateShift)) & FieldMask(SortKeyMeshBits)];
+
+        if (shader != currentShader)
+        {
+            shader->Use();
+            currentShader = shader;
+            ++shaderChangeCount;
+        }
+
+        renderer.DrawBatch(*mesh, instances, runStart, i - runStart);
+        ++drawCallCount;
+
+        runStart = i;
+    }
+}
+
+void RenderQueue::ExecuteIndirect(GpuDrivenRenderer& renderer)
+{
+    // betelt stream buffernél csak a statisztika készül el, nincs rajzolás
+    const StreamAllocation instances = renderer.AllocateInstances(CountPackets());
+    Prepare(reinterpret_cast<InstanceData*>(instances.data));
+
+    if (!instances.IsValid())
+        return;
+
+    const Shader* currentShader = nullptr;
+    std::size_t runStart = 0;
+
+    for (std::size_t i = 1; i <= packetCount; ++i)
+    {
+        const std::uint64_t runState = sortEntries[runStart].key >> StateShift;
+
+        if (i < packetCount && (sortEntries[i].key >> StateShift) == runState)
+            continue;
+
+        const std::uint32_t meshId = static_cast<std::uint32_t>((runState >> (MeshShift - StateShift)) & FieldMask(SortKeyMeshBits));
+
+        renderer.AddDraw(meshId, static_cast<std::uint32_t>(runStart), static_cast<std::uint32_t>(i - runStart));
+
+        // pass vagy shader váltásnál (és a végén) kimegy az eddig gyűjtött multi-draw
+        if (i == packetCount || (sortEntries[i].key >> ShaderShift) != (runState >> (ShaderShift - StateShift)))
+        {
+            const Shader* shader = shaders[(runState >> (ShaderShift - StateShift)) & FieldMask(SortKeyShaderBits)];
+
+            if (shader != currentShader)
+            {
+                shader->Use();
+                currentShader = shader;
+                ++shaderChangeCount;
+            }
+
+            renderer.Submit();
+            ++drawCallCount;
+        }
+
+        runStart = i;
+    }
+}
+
+std::size_t RenderQueue::GetPacketCount() const
+{
+    return packetCount;
+}
+
+int RenderQueue::GetDrawCallCount() const
+{
+    return drawCallCount;
+}
+
+int RenderQueue::GetShaderChangeCount() const
+{
+    return shaderChangeCount;
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "FrameArena.h"
+#include "InstancedRenderer.h"
+#include "JobSystem.h"
+
+class GpuDrivenRenderer;
+class Mesh;
+class Shader;
+
+// 64 bites rendezési kulcs, a legfelső bitektől:
+//   pass (4) | shader (8) | mesh (12) | material (16) | depth (24)
+// A rendezés után az azonos állapotú csomagok egymás mellé kerülnek, az
+// állapoton belül pedig elölről hátrafelé (early-z) jönnek.
+enum class RenderPass : std::uint32_t
+{
+    Opaque,
+
+    Count
+};
+
+constexpr int SortKeyDepthBits = 24;
+constexpr int SortKeyMaterialBits = 16;
+constexpr int SortKeyMeshBits = 12;
+constexpr int SortKeyShaderBits = 8;
+constexpr int SortKeyPassBits = 4;
+
+static_assert(SortKeyDepthBits + SortKeyMaterialBits + SortKeyMeshBits + SortKeyShaderBits + SortKeyPassBits == 64);
+
+// normalizedDepth: 0 a kamera, 1 a távoli sík (kívül eső értéket levág)
+std::uint64_t MakeSortKey(RenderPass pass, std::uint32_t shaderId, std::uint32_t meshId, std::uint32_t material, float normalizedDepth);
+
+// Rajzolási csomag: a kulcs és a példány adata (a shader és a mesh a kulcsból jön)
+struct RenderPacket
+{
+    std::uint64_t sortKey;
+    InstanceData instance;
+};
+
+// Egy munkaszál saját csomaglistája, így az írás nem igényel szinkronizálást.
+// A csomagok a szál képkocka arénájában vannak.
+class RenderCommandList
+{
+public:
+    explicit RenderCommandList(LinearArena& arena);
+
+    void Add(std::uint64_t sortKey, const glm::mat4& model, const glm::vec3& color, bool useVertexColor);
+
+private:
+    friend class RenderQueue;
+
+    ArenaVector<RenderPacket> packets;
+    std::size_t reserveHint = 0; // az előző képkocka csomagszáma
+};
+
+// Képkockánkénti parancs buffer. A csomagokat munkaszálak töltik (Build),
+// a GL szálon radix rendezés után állapotonként egy példányosított rajzolás
+// megy ki (Execute), a felesleges shader váltásokat kihagyva.
+class RenderQueue
+{
+public:
+    // A Build és a rendezett gyűjtés a job rendszeren fut, szálanként egy listával.
+    // A csomagok és a rendezés tömbjei a képkocka arénából jönnek, ezért csak a
+    // képkocka végéig érvényesek: a Begin-t minden képkockán hívni kell.
+    RenderQueue(JobSystem& jobs, FrameArena& frameArena);
+
+    // A kulcsba kerülő azonosítók; induláskor egyszer regisztráljuk.
+    // Legfeljebb 256 shader és 4096 mesh fér a kulcsba, a többi leállítja a programot.
+    std::uint32_t RegisterShader(const Shader& shader);
+    std::uint32_t RegisterMesh(const Mesh& mesh);
+
+    void Begin();
+
+    // A [0, itemCount) tartományt darabokra bontja, és a darabokat párhuzamosan
+    // adja a build függvénynek. Visszatéréskor minden darab kész.
+    using BuildFunction = std::function<void(std::size_t first, std::size_t last, RenderCommandList& commands)>;
+    void Build(std::size_t itemCount, const BuildFunction& build);
+
+    // Rendez és kirajzol; csak a GL szálon hívható
+    void Execute(InstancedRenderer& renderer);
+
+    // GPU-driven változat: passonként és shaderenként egy glMultiDrawElementsIndirect,
+    // az állapotok a parancstömb elemei lesznek. A meshId-knek a rendererben is
+    // regisztrálva kell lenniük (GpuDrivenRenderer::AddMesh).
+    void ExecuteIndirect(GpuDrivenRenderer& renderer);
+
+    // az utolsó Execute statisztikája (indirect esetben a draw hívás a multi-draw)
+    std::size_t GetPacketCount() const;
+    int GetDrawCallCount() const;
+    int GetShaderChangeCount() const;
+
+private:
+    struct SortEntry
+    {
+        std::uint64_t key;
+        std::uint32_t packet;
+    };
+
+    // A [0, itemCount) darabjait a job rendszer szálai (a hívóval együtt) dolgozzák fel
+    using ChunkFunction = std::function<void(int thread, std::size_t first, std::size_t last)>;
+    void ForEachChunk(std::size_t itemCount, const ChunkFunction& work);
+
+    std::size_t CountPackets() const;
+    void Sort();
+
+    // Rendez, nullázza a statisztikát, és a példányokat rendezett sorrendben
+    // párhuzamosan a célba (a stream buffer képkockarészébe) írja
+    void Prepare(InstanceData* destination);
+
+private:
+    JobSystem& jobs;
+    FrameArena& frameArena;
+
+    std::vector<const Shader*> shaders;
+    std::vector<const Mesh*> meshes;
+
+    std::vector<RenderCommandList> commandLists; // munkaszálanként egy
+
+    SortEntry* sortEntries = nullptr; // rendezve, a hívó szál arénájában
+
+    std::size_t packetCount = 0;
+    int drawCallCount = 0;
+    int shaderChangeCount = 0;
+};
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "RenderVerification.h"
+
+#ifdef ENGINE_DEBUG
+
+#include <algorithm>
+#include <cstdlib>
+#include <glad/glad.h>
+
+OffscreenFramebuffer::OffscreenFramebuffer(int width, int height)
+    : width(width),
+    height(height)
+{
+    glCreateRenderbuffers(1, &colorBuffer);
+    glNamedRenderbufferStorage(colorBuffer, GL_RGBA8, width, height);
+
+    glCreateRenderbuffers(1, &depthBuffer);
+    glNamedRenderbufferStorage(depthBuffer, GL_DEPTH_COMPONENT24, width, height);
+
+    glCreateFramebuffers(1, &framebuffer);
+    glNamedFramebufferRenderbuffer(framebuffer, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glNamedFramebufferRenderbuffer(framebuffer, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+}
+
+OffscreenFramebuffer::~OffscreenFramebuffer()
+{
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteRenderbuffers(1, &colorBuffer);
+    glDeleteRenderbuffers(1, &depthBuffer);
+}
+
+bool OffscreenFramebuffer::IsComplete() const
+{
+    return glCheckNamedFramebufferStatus(framebuffer, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+std::vector<std::uint8_t> OffscreenFramebuffer::Capture(const std::function<void()>& draw)
+{
+    // a hívó viewportját és framebufferét visszaállítjuk, a képkocka többi része nem tud a mentésről
+    GLint previousViewport[4];
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, width, height);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    draw();
+
+    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * height * 4);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glNamedFramebufferReadBuffer(framebuffer, GL_COLOR_ATTACHMENT0);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+
+    return pixels;
+}
+
+ImageDifference CompareImages(const std::vector<std::uint8_t>& a, const std::vector<std::uint8_t>& b, int tolerance)
+{
+    ImageDifference difference;
+
+    if (a.size() != b.size())
+    {
+        difference.differentPixels = std::max(a.size(), b.size()) / 4;
+        difference.maxChannelDifference = 255;
+        return difference;
+    }
+
+    for (std::size_t pixel = 0; pixel < a.size(); pixel += 4)
+    {
+        int pixelDifference = 0;
+
+        for (std::size_t channel = 0; channel < 4; ++channel)
+        {
+            pixelDifference = std::max(pixelDifference, std::abs(a[pixel + channel] - b[pixel + channel]));
+        }
+
+        difference.maxChannelDifference = std::max(difference.maxChannelDifference, pixelDifference);
+
+        if (pixelDifference > tolerance)
+            ++difference.differentPixels;
+    }
+
+    return difference;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#ifdef ENGINE_DEBUG
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Képernyőn kívüli RGBA8 + 24 bites mélység framebuffer, a rajzolási utak
+// képének összehasonlításához (pl. klasszikus vs. GPU-driven, llvmpipe alatt is)
+class OffscreenFramebuffer
+{
+public:
+    OffscreenFramebuffer(int width, int height);
+    ~OffscreenFramebuffer();
+
+    OffscreenFramebuffer(const OffscreenFramebuffer&) = delete;
+    OffscreenFramebuffer& operator=(const OffscreenFramebuffer&) = delete;
+
+    bool IsComplete() const;
+
+    // Beköti és törli a buffert, lefuttatja a draw-t, majd visszaolvassa a képet.
+    // Utána a korábbi framebuffer és viewport lesz újra érvényben.
+    std::vector<std::uint8_t> Capture(const std::function<void()>& draw);
+
+private:
+    int width;
+    int height;
+
+    unsigned int framebuffer = 0;
+    unsigned int colorBuffer = 0;
+    unsigned int depthBuffer = 0;
+};
+
+struct ImageDifference
+{
+    std::size_t differentPixels = 0;
+    int maxChannelDifference = 0;
+};
+
+// Csatornánként tolerance-nél nagyobb eltérés számít különbségnek
+ImageDifference CompareImages(const std::vector<std::uint8_t>& a, const std::vector<std::uint8_t>& b, int tolerance = 0);
+
+#endif
\ No newline at end of file
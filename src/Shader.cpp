@@ -1,84 +1,135 @@
 #include "Shader.h"
 
 #include <glad/glad.h>
-#include <iostream>
 
 #include <glm/gtc/type_ptr.hpp>
 
-Shader::Shader(const char* vertexSource, const char* fragmentSource)
+Shader::~Shader()
 {
-    unsigned int vertexShader = CompileShader(GL_VERTEX_SHADER, vertexSource);
-    unsigned int fragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentSource);
+    glDeleteProgram(programId);
+}
 
-    programId = glCreateProgram();
-    glAttachShader(programId, vertexShader);
-    glAttachShader(programId, fragmentShader);
-    glLinkProgram(programId);
+void Shader::Use() const
+{
+    glUseProgram(programId);
+}
 
-    int success = 0;
-    glGetProgramiv(programId, GL_LINK_STATUS, &success);
-    if (success == GL_FALSE)
+UniformHandle Shader::GetUniform(const char* name) const
+{
+    auto it = uniformLocations.find(name);
+    if (it == uniformLocations.end())
     {
-        char infoLog[512];
-        glGetProgramInfoLog(programId, 512, nullptr, infoLog);
-        std::cerr << "Shader link error: " << infoLog << "\n";
+        return {};
     }
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    return { it->second };
 }
 
-Shader::~Shader()
+void Shader::SetMat4(UniformHandle handle, const glm::mat4& matrix) const
 {
-    glDeleteProgram(programId);
+    if (handle.IsValid())
+    {
+        glProgramUniformMatrix4fv(programId, handle.location, 1, GL_FALSE, glm::value_ptr(matrix));
+    }
 }
 
-void Shader::Use() const
+void Shader::SetVec3(UniformHandle handle, const glm::vec3& value) const
 {
-    glUseProgram(programId);
+    if (handle.IsValid())
+    {
+        glProgramUniform3fv(programId, handle.location, 1, glm::value_ptr(value));
+    }
 }
 
-void Shader::SetMat4(const char* name, const glm::mat4& matrix) const
+void Shader::SetBool(UniformHandle handle, bool value) const
 {
-    int location = glGetUniformLocation(programId, name);
-    if (location != -1)
+    if (handle.IsValid())
     {
-        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+        glProgramUniform1i(programId, handle.location, value ? 1 : 0);
     }
 }
 
-unsigned int Shader::CompileShader(unsigned int type, const char* source)
+void Shader::SetMat4(const char* name, const glm::mat4& matrix) const
 {
-    unsigned int shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, nullptr);
-    glCompileShader(shader);
+    SetMat4(GetUniform(name), matrix);
+}
 
-    int success = 0;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (success == GL_FALSE)
+bool Shader::BindUniformBlock(const char* name, unsigned int bindingPoint)
+{
+    auto it = uniformBlocks.find(name);
+    if (it == uniformBlocks.end())
     {
-        char infoLog[512];
-        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        std::cerr << "Shader compile error: " << infoLog << "\n";
+        return false;
     }
 
-    return shader;
+    uniformBlockBindings[name] = bindingPoint;
+
+    glUniformBlockBinding(programId, it->second, bindingPoint);
+    return true;
 }
 
-void Shader::SetVec3(const char* name, const glm::vec3& value) const
+void Shader::SetProgram(unsigned int program)
 {
-    int location = glGetUniformLocation(programId, name);
-    if (location != -1)
+    glDeleteProgram(programId);
+    programId = program;
+
+    uniformLocations.clear();
+    uniformBlocks.clear();
+
+    ReflectUniforms();
+
+    for (const auto& [name, bindingPoint] : uniformBlockBindings)
     {
-        glUniform3fv(location, 1, glm::value_ptr(value));
+        auto it = uniformBlocks.find(name);
+        if (it != uniformBlocks.end())
+        {
+            glUniformBlockBinding(programId, it->second, bindingPoint);
+        }
     }
 }
 
-void Shader::SetBool(const char* name, bool value) const
+void Shader::ReflectUniforms()
 {
-    int location = glGetUniformLocation(programId, name);
-    if (location != -1)
+    char name[256];
+
+    // ---- Uniforms ----
+    int uniformCount = 0;
+    glGetProgramInterfaceiv(programId, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniformCount);
+
+    for (int i = 0; i < uniformCount; ++i)
+    {
+        const GLenum properties[] = { GL_LOCATION, GL_BLOCK_INDEX };
+        int values[2] = {};
+
+        glGetProgramResourceiv(programId, GL_UNIFORM, i, 2, properties, 2, nullptr, values);
+
+        // blokk tagjainak nincs saját helye, azokat a uniform buffer adja
+        if (values[0] == -1 || values[1] != -1)
+        {
+            continue;
+        }
+
+        glGetProgramResourceName(programId, GL_UNIFORM, i, sizeof(name), nullptr, name);
+        uniformLocations[name] = values[0];
+    }
+
+    // ---- Uniform blocks ----
+    int blockCount = 0;
+    glGetProgramInterfaceiv(programId, GL_UNIFORM_BLOCK, GL_ACTIVE_RESOURCES, &blockCount);
+
+    for (int i = 0; i < blockCount; ++i)
     {
-        glUniform1i(location, value ? 1 : 0);
+        glGetProgramResourceName(programId, GL_UNIFORM_BLOCK, i, sizeof(name), nullptr, name);
+        uniformBlocks[name] = static_cast<unsigned int>(i);
     }
+}
+
+void Shader::SetVec3(const char* name, const glm::vec3& value) const
+{
+    SetVec3(GetUniform(name), value);
+}
+
+void Shader::SetBool(const char* name, bool value) const
+{
+    SetBool(GetUniform(name), value);
 }
\ No newline at end of file
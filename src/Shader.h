@@ -1,23 +1,66 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <glm/vec3.hpp>
 #include <glm/mat4x4.hpp>
 
+// Linkeléskor lekérdezett uniform helye; a forró úton név helyett ezt használjuk.
+// Újratöltés után csak explicit (layout(location = N)) helyű uniformra marad érvényes.
+struct UniformHandle
+{
+    int location = -1;
+
+    bool IsValid() const
+    {
+        return location != -1;
+    }
+};
+
+// Egy linkelt program. Csak a ShaderLibrary hozza létre fájlból (gyorsítótárral
+// és újratöltéssel), a program a Shader élete alatt kicserélődhet.
 class Shader
 {
 public:
-    Shader(const char* vertexSource, const char* fragmentSource);
     ~Shader();
 
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+
     void Use() const;
+
+    // A reflektált uniformok közül keres, GL hívás nélkül. Nem létező vagy
+    // blokkban lévő uniformra érvénytelen handle-t ad (a Set nem csinál semmit).
+    UniformHandle GetUniform(const char* name) const;
+
+    // A handle-ös változatok glProgramUniform-ot hívnak, Use nélkül is működnek
+    void SetMat4(UniformHandle handle, const glm::mat4& matrix) const;
+    void SetVec3(UniformHandle handle, const glm::vec3& value) const;
+    void SetBool(UniformHandle handle, bool value) const;
+
+    // Kényelmi változatok: a gyorsítótárból keresnek, nem a drivertől
     void SetMat4(const char* name, const glm::mat4& matrix) const;
     void SetVec3(const char* name, const glm::vec3& value) const;
     void SetBool(const char* name, bool value) const;
 
+    // Az uniform blokkot a megadott binding pointhoz köti; false, ha nincs ilyen blokk.
+    // A kötés a program cseréje után is megmarad.
+    bool BindUniformBlock(const char* name, unsigned int bindingPoint);
+
 private:
-    unsigned int programId;
+    friend class ShaderLibrary;
+
+    Shader() = default;
+
+    // Átveszi a (sikeresen linkelt) programot, a régit törli
+    void SetProgram(unsigned int program);
+
+    void ReflectUniforms();
 
 private:
-    unsigned int CompileShader(unsigned int type, const char* source);
+    unsigned int programId = 0;
+
+    std::unordered_map<std::string, int> uniformLocations;
+    std::unordered_map<std::string, unsigned int> uniformBlocks; // név -> blokk index
+    std::unordered_map<std::string, unsigned int> uniformBlockBindings; // név -> binding point
 };
\ No newline at end of file
@@ -0,0 +1,580 @@
+#include "ShaderLibrary.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// KHR_parallel_shader_compile (az ARB változat ugyanezeket az értékeket használja);
+// a glad csak a core 4.6-ot tölti be, a bővítményt kézzel kérdezzük le
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+
+namespace
+{
+    using MaxShaderCompilerThreadsFunction = void (*)(GLuint count);
+
+    constexpr char ProgramBinaryMagic[4] = { 'Z', 'S', 'P', 'B' };
+    constexpr std::uint32_t ProgramBinaryVersion = 1;
+
+    // a gyorsítótár fájl eleje, utána binarySize bájt program bináris
+    struct ProgramBinaryHeader
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t cacheKey;
+        std::uint32_t binaryFormat;
+        std::uint32_t binarySize;
+    };
+
+#ifdef ENGINE_DEBUG
+    constexpr std::chrono::milliseconds HotReloadWatchInterval(500);
+
+    // párhuzamos fordítás nélkül ennyit adunk a drivernek a linkelés lekérdezése előtt
+    constexpr std::chrono::milliseconds HotReloadSerialLinkDelay(250);
+#endif
+
+    constexpr std::uint64_t FnvOffsetBasis = 14695981039346656037ull;
+    constexpr std::uint64_t FnvPrime = 1099511628211ull;
+
+    // FNV-1a; a szeparátor miatt "ab"+"c" és "a"+"bc" más kulcs
+    std::uint64_t HashString(std::uint64_t hash, const std::string& text)
+    {
+        for (char c : text)
+        {
+            hash = (hash ^ static_cast<unsigned char>(c)) * FnvPrime;
+        }
+
+        return (hash ^ 0xFFu) * FnvPrime;
+    }
+
+    std::string GetGLString(GLenum name)
+    {
+        const GLubyte* value = glGetString(name);
+        return value != nullptr ? reinterpret_cast<const char*>(value) : "";
+    }
+
+    bool HasExtension(const char* name)
+    {
+        int extensionCount = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+
+        for (int i = 0; i < extensionCount; ++i)
+        {
+            const GLubyte* extension = glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i));
+            if (extension != nullptr && std::strcmp(reinterpret_cast<const char*>(extension), name) == 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    bool ReadTextFile(const std::filesystem::path& path, std::string& outText)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "Failed to open shader: " << path.string() << "\n";
+            return false;
+        }
+
+        std::ostringstream text;
+        text << file.rdbuf();
+        outText = text.str();
+
+        return true;
+    }
+
+    std::filesystem::file_time_type GetWriteTime(const std::filesystem::path& path)
+    {
+        std::error_code error;
+        const std::filesystem::file_time_type time = std::filesystem::last_write_time(path, error);
+
+        return error ? std::filesystem::file_time_type{} : time;
+    }
+
+    unsigned int StartCompile(GLenum type, const std::string& source)
+    {
+        const char* text = source.c_str();
+
+        unsigned int shader = glCreateShader(type);
+        glShaderSource(shader, 1, &text, nullptr);
+        glCompileShader(shader);
+
+        return shader;
+    }
+
+    void PrintCompileLog(unsigned int shader, const std::string& file)
+    {
+        int success = 0;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (success != GL_FALSE)
+            return;
+
+        char infoLog[512];
+        glGetShaderInfoLog(shader, sizeof(infoLog), nullptr, infoLog);
+        std::cerr << "Shader compile error (" << file << "): " << infoLog << "\n";
+    }
+}
+
+ShaderLibrary::ShaderLibrary(JobSystem& jobs, std::string shaderDirectory, std::string cacheDirectory)
+    : jobs(jobs),
+    shaderDirectory(std::move(shaderDirectory)),
+    cacheDirectory(std::move(cacheDirectory))
+{
+    driverId =
+        GetGLString(GL_VENDOR) + "|" +
+        GetGLString(GL_RENDERER) + "|" +
+        GetGLString(GL_VERSION) + "|" +
+        GetGLString(GL_SHADING_LANGUAGE_VERSION);
+
+    int binaryFormatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+    binaryCacheSupported = binaryFormatCount > 0;
+
+    if (binaryCacheSupported)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(this->cacheDirectory, error);
+
+        if (error)
+        {
+            std::cerr << "Failed to create shader cache directory: " << this->cacheDirectory << "\n";
+            binaryCacheSupported = false;
+        }
+    }
+
+    MaxShaderCompilerThreadsFunction maxShaderCompilerThreads = nullptr;
+
+    if (HasExtension("GL_KHR_parallel_shader_compile"))
+    {
+        maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsFunction>(glfwGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+    }
+    else if (HasExtension("GL_ARB_parallel_shader_compile"))
+    {
+        maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsFunction>(glfwGetProcAddress("glMaxShaderCompilerThreadsARB"));
+    }
+
+    parallelCompileSupported = maxShaderCompilerThreads != nullptr;
+
+    // 0xFFFFFFFF: a driver annyi szálat használ, amennyit jónak lát
+    if (parallelCompileSupported)
+    {
+        maxShaderCompilerThreads(0xFFFFFFFFu);
+    }
+
+#ifdef ENGINE_DEBUG
+    nextWatchTime = std::chrono::steady_clock::now() + HotReloadWatchInterval;
+#endif
+}
+
+ShaderLibrary::~ShaderLibrary()
+{
+#ifdef ENGINE_DEBUG
+    // a fájlfigyelő job a watchedSources-ba ír
+    if (watchRunning)
+    {
+        jobs.Wait(watchCounter);
+    }
+#endif
+
+    auto Release = [](const PendingProgram& program)
+    {
+        glDeleteShader(program.vertexShader);
+        glDeleteShader(program.fragmentShader);
+        glDeleteProgram(program.program);
+    };
+
+    std::for_each(pending.begin(), pending.end(), Release);
+
+#ifdef ENGINE_DEBUG
+    std::for_each(reloads.begin(), reloads.end(), Release);
+#endif
+}
+
+Shader& ShaderLibrary::Load(const std::string& vertexFile, const std::string& fragmentFile)
+{
+    const std::size_t index = entries.size();
+
+    Entry& entry = entries.emplace_back();
+    entry.shader.reset(new Shader());
+    entry.vertexFile = vertexFile;
+    entry.fragmentFile = fragmentFile;
+
+    std::string vertexSource;
+    std::string fragmentSource;
+
+    if (!ReadSources(entry, vertexSource, fragmentSource))
+    {
+        loadFailed = true;
+        return *entry.shader;
+    }
+
+    const std::uint64_t cacheKey = MakeCacheKey(vertexSource, fragmentSource);
+
+    if (unsigned int program = LoadCachedProgram(cacheKey); program != 0)
+    {
+        entry.shader->SetProgram(program);
+        ++cacheHitCount;
+        return *entry.shader;
+    }
+
+    pending.push_back(StartProgram(index, vertexSource, fragmentSource, cacheKey));
+
+    return *entry.shader;
+}
+
+bool ShaderLibrary::Finish()
+{
+    for (const PendingProgram& program : pending)
+    {
+        const unsigned int linked = FinishProgram(program);
+
+        if (linked == 0)
+        {
+            loadFailed = true;
+            continue;
+        }
+
+        entries[program.entry].shader->SetProgram(linked);
+        StoreCachedProgram(program.cacheKey, linked);
+    }
+
+    pending.clear();
+
+    return !loadFailed;
+}
+
+bool ShaderLibrary::IsParallelCompileSupported() const
+{
+    return parallelCompileSupported;
+}
+
+int ShaderLibrary::GetProgramCount() const
+{
+    return static_cast<int>(entries.size());
+}
+
+int ShaderLibrary::GetCacheHitCount() const
+{
+    return cacheHitCount;
+}
+
+#ifdef ENGINE_DEBUG
+
+void ShaderLibrary::UpdateHotReload()
+{
+    const auto now = std::chrono::steady_clock::now();
+
+    // ---- Finished reloads ----
+    // párhuzamos fordítás nélkül a lekérdezés megvárhatja a drivert: csak
+    // késleltetve, és képkockánként legfeljebb egyet
+    bool linkQueried = false;
+
+    for (auto it = reloads.begin(); it != reloads.end();)
+    {
+        const bool ready = parallelCompileSupported
+            ? IsComplete(*it)
+            : !linkQueried && now - it->startTime >= HotReloadSerialLinkDelay;
+
+        if (!ready)
+        {
+            ++it;
+            continue;
+        }
+
+        linkQueried = true;
+
+        const Entry& entry = entries[it->entry];
+
+        if (const unsigned int linked = FinishProgram(*it); linked != 0)
+        {
+            entry.shader->SetProgram(linked);
+            StoreCachedProgram(it->cacheKey, linked);
+
+            std::cout << "Shader reloaded: " << entry.vertexFile << ", " << entry.fragmentFile << "\n";
+        }
+
+        it = reloads.erase(it);
+    }
+
+    // ---- Finished file watch ----
+    if (watchRunning && watchCounter.IsDone())
+    {
+        watchRunning = false;
+
+        for (WatchedSource& source : watchedSources)
+        {
+            if (!source.changed)
+                continue;
+
+            Entry& entry = entries[source.entry];
+            entry.vertexWriteTime = source.vertexWriteTime;
+            entry.fragmentWriteTime = source.fragmentWriteTime;
+
+            // a fájl éppen íródhat: a hibás fordítás után a következő mentés újra próbálja
+            if (!source.readSucceeded)
+                continue;
+
+            PendingProgram& program = reloads.emplace_back(StartProgram(
+                source.entry,
+                source.vertexSource,
+                source.fragmentSource,
+                MakeCacheKey(source.vertexSource, source.fragmentSource)));
+
+            program.startTime = now;
+        }
+    }
+
+    // ---- File watch ----
+    if (watchRunning || now < nextWatchTime)
+        return;
+
+    nextWatchTime = now + HotReloadWatchInterval;
+
+    watchedSources.clear();
+
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+        const Entry& entry = entries[i];
+
+        const bool reloading = std::any_of(reloads.begin(), reloads.end(), [i](const PendingProgram& program)
+        {
+            return program.entry == i;
+        });
+
+        if (reloading)
+            continue;
+
+        WatchedSource& source = watchedSources.emplace_back();
+        source.entry = i;
+        source.vertexPath = std::filesystem::path(shaderDirectory) / entry.vertexFile;
+        source.fragmentPath = std::filesystem::path(shaderDirectory) / entry.fragmentFile;
+        source.vertexWriteTime = entry.vertexWriteTime;
+        source.fragmentWriteTime = entry.fragmentWriteTime;
+    }
+
+    if (watchedSources.empty())
+        return;
+
+    // a stat és az olvasás a fő szálon képkockákat akaszthatna meg (hálózati meghajtó, víruskereső)
+    watchRunning = true;
+    jobs.Run(watchCounter, watchJob);
+}
+
+void ShaderLibrary::WatchSources()
+{
+    for (WatchedSource& source : watchedSources)
+    {
+        const std::filesystem::file_time_type vertexWriteTime = GetWriteTime(source.vertexPath);
+        const std::filesystem::file_time_type fragmentWriteTime = GetWriteTime(source.fragmentPath);
+
+        source.changed = vertexWriteTime != source.vertexWriteTime || fragmentWriteTime != source.fragmentWriteTime;
+
+        if (!source.changed)
+            continue;
+
+        // az időt olvasás előtt vesszük, így a közben mentett változás sem vész el
+        source.vertexWriteTime = vertexWriteTime;
+        source.fragmentWriteTime = fragmentWriteTime;
+
+        source.readSucceeded =
+            ReadTextFile(source.vertexPath, source.vertexSource) &&
+            ReadTextFile(source.fragmentPath, source.fragmentSource);
+    }
+}
+
+#endif
+
+bool ShaderLibrary::ReadSources(Entry& entry, std::string& outVertexSource, std::string& outFragmentSource) const
+{
+    const std::filesystem::path vertexPath = std::filesystem::path(shaderDirectory) / entry.vertexFile;
+    const std::filesystem::path fragmentPath = std::filesystem::path(shaderDirectory) / entry.fragmentFile;
+
+    // az időt olvasás előtt vesszük, így a közben mentett változás sem vész el
+    entry.vertexWriteTime = GetWriteTime(vertexPath);
+    entry.fragmentWriteTime = GetWriteTime(fragmentPath);
+
+    return ReadTextFile(vertexPath, outVertexSource) && ReadTextFile(fragmentPath, outFragmentSource);
+}
+
+std::uint64_t ShaderLibrary::MakeCacheKey(const std::string& vertexSource, const std::string& fragmentSource) const
+{
+    std::uint64_t hash = FnvOffsetBasis;
+    hash = HashString(hash, driverId);
+    hash = HashString(hash, vertexSource);
+    hash = HashString(hash, fragmentSource);
+
+    return hash;
+}
+
+std::string ShaderLibrary::GetCachePath(std::uint64_t cacheKey) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(cacheKey));
+
+    return (std::filesystem::path(cacheDirectory) / name).string();
+}
+
+unsigned int ShaderLibrary::LoadCachedProgram(std::uint64_t cacheKey) const
+{
+    if (!binaryCacheSupported)
+        return 0;
+
+    const std::string path = GetCachePath(cacheKey);
+
+    std::error_code error;
+    if (!std::filesystem::exists(path, error))
+        return 0;
+
+    MappedFile file;
+    if (!file.Open(path))
+        return 0;
+
+    ProgramBinaryHeader header;
+    if (file.GetSize() < sizeof(header))
+        return 0;
+
+    std::memcpy(&header, file.GetData(), sizeof(header));
+
+    if (std::memcmp(header.magic, ProgramBinaryMagic, sizeof(header.magic)) != 0 ||
+        header.version != ProgramBinaryVersion ||
+        header.cacheKey != cacheKey ||
+        file.GetSize() - sizeof(header) < header.binarySize)
+    {
+        return 0;
+    }
+
+    unsigned int program = glCreateProgram();
+    glProgramBinary(program, header.binaryFormat, file.GetData() + sizeof(header), static_cast<GLsizei>(header.binarySize));
+
+    // a driver a saját régebbi binárisát is elutasíthatja, ekkor fordítunk
+    int success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (success == GL_FALSE)
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+void ShaderLibrary::StoreCachedProgram(std::uint64_t cacheKey, unsigned int program) const
+{
+    if (!binaryCacheSupported)
+        return;
+
+    int binarySize = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+    if (binarySize <= 0)
+        return;
+
+    std::vector<std::byte> binary(static_cast<std::size_t>(binarySize));
+
+    GLenum binaryFormat = 0;
+    glGetProgramBinary(program, binarySize, &binarySize, &binaryFormat, binary.data());
+
+    ProgramBinaryHeader header = {};
+    std::memcpy(header.magic, ProgramBinaryMagic, sizeof(header.magic));
+    header.version = ProgramBinaryVersion;
+    header.cacheKey = cacheKey;
+    header.binaryFormat = binaryFormat;
+    header.binarySize = static_cast<std::uint32_t>(binarySize);
+
+    // ideiglenes fájlba írunk, így megszakadt írás után sem marad fél bináris
+    const std::string path = GetCachePath(cacheKey);
+    const std::string temporaryPath = path + ".tmp";
+
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(binary.data()), binarySize);
+
+        if (!file)
+        {
+            std::cerr << "Failed to write shader cache: " << temporaryPath << "\n";
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+
+    if (error)
+    {
+        std::cerr << "Failed to write shader cache: " << path << "\n";
+        std::filesystem::remove(temporaryPath, error);
+    }
+}
+
+ShaderLibrary::PendingProgram ShaderLibrary::StartProgram(std::size_t entry, const std::string& vertexSource, const std::string& fragmentSource, std::uint64_t cacheKey) const
+{
+    PendingProgram result;
+    result.entry = entry;
+    result.cacheKey = cacheKey;
+
+    // a státuszt itt még nem kérdezzük le, különben a hívás megvárja a fordítást
+    result.vertexShader = StartCompile(GL_VERTEX_SHADER, vertexSource);
+    result.fragmentShader = StartCompile(GL_FRAGMENT_SHADER, fragmentSource);
+
+    result.program = glCreateProgram();
+    glAttachShader(result.program, result.vertexShader);
+    glAttachShader(result.program, result.fragmentShader);
+
+    if (binaryCacheSupported)
+    {
+        glProgramParameteri(result.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    glLinkProgram(result.program);
+
+    return result;
+}
+
+bool ShaderLibrary::IsComplete(const PendingProgram& pending) const
+{
+    if (!parallelCompileSupported)
+        return true;
+
+    int complete = 0;
+    glGetProgramiv(pending.program, GL_COMPLETION_STATUS_KHR, &complete);
+
+    return complete != GL_FALSE;
+}
+
+unsigned int ShaderLibrary::FinishProgram(const PendingProgram& pending) const
+{
+    const Entry& entry = entries[pending.entry];
+
+    int success = 0;
+    glGetProgramiv(pending.program, GL_LINK_STATUS, &success);
+
+    if (success == GL_FALSE)
+    {
+        PrintCompileLog(pending.vertexShader, entry.vertexFile);
+        PrintCompileLog(pending.fragmentShader, entry.fragmentFile);
+
+        char infoLog[512];
+        glGetProgramInfoLog(pending.program, sizeof(infoLog), nullptr, infoLog);
+        std::cerr << "Shader link error (" << entry.vertexFile << ", " << entry.fragmentFile << "): " << infoLog << "\n";
+    }
+
+    glDetachShader(pending.program, pending.vertexShader);
+    glDetachShader(pending.program, pending.fragmentShader);
+    glDeleteShader(pending.vertexShader);
+    glDeleteShader(pending.fragmentShader);
+
+    if (success == GL_FALSE)
+    {
+        glDeleteProgram(pending.program);
+        return 0;
+    }
+
+    return pending.program;
+}
\ No newline at end of file
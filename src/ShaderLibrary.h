@@ -0,0 +1,145 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "JobSystem.h"
+#include "Shader.h"
+
+// Fájlból töltött shaderek. A linkelt programok binárisa a gyorsítótár
+// könyvtárba kerül (glGetProgramBinary); a kulcs a források és a driver
+// hash-e, így a következő indításkor a glProgramBinary kihagyja a fordítást.
+//
+// A Load csak elindítja a fordítást és a linkelést, az eredményt a Finish
+// kérdezi le egyben. A driver így a programokat egymással párhuzamosan
+// fordíthatja (KHR_parallel_shader_compile esetén a saját szálain).
+class ShaderLibrary
+{
+public:
+    // A jobs a hot reload fájlfigyeléséhez kell, túl kell élnie a könyvtárat
+    ShaderLibrary(JobSystem& jobs, std::string shaderDirectory, std::string cacheDirectory);
+    ~ShaderLibrary();
+
+    ShaderLibrary(const ShaderLibrary&) = delete;
+    ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+
+    // A fájlnevek a shader könyvtárhoz képest értendők. A Shader a Finish után
+    // használható, és a könyvtár élete alatt érvényes marad.
+    Shader& Load(const std::string& vertexFile, const std::string& fragmentFile);
+
+    // Megvárja a függő linkeléseket; false, ha valamelyik program hibás
+    bool Finish();
+
+    bool IsParallelCompileSupported() const;
+    int GetProgramCount() const;
+    int GetCacheHitCount() const;
+
+#ifdef ENGINE_DEBUG
+    // Képkockánként hívandó. Időnként egy job megnézi a fájlok módosítási
+    // idejét és beolvassa a változott forrásokat; a fő szál csak a kész job
+    // eredményéből indít fordítást, és a kész programot kicseréli; hibás új
+    // forrásnál a régi marad. Párhuzamos fordításnál a képkocka nem vár a
+    // driverre. Enélkül a linkelés lekérdezését késleltetjük (a driver addig a
+    // háttérben végezhet), és képkockánként legfeljebb egyet kérdezünk le.
+    void UpdateHotReload();
+#endif
+
+private:
+    struct Entry
+    {
+        std::unique_ptr<Shader> shader;
+        std::string vertexFile;
+        std::string fragmentFile;
+        std::filesystem::file_time_type vertexWriteTime;
+        std::filesystem::file_time_type fragmentWriteTime;
+    };
+
+    // elindított, még le nem kérdezett linkelés
+    struct PendingProgram
+    {
+        std::size_t entry = 0;
+        unsigned int program = 0;
+        unsigned int vertexShader = 0;
+        unsigned int fragmentShader = 0;
+        std::uint64_t cacheKey = 0;
+
+        // hot reload: a linkelés indítása, párhuzamos fordítás nélkül ehhez képest késleltetünk
+        std::chrono::steady_clock::time_point startTime{};
+    };
+
+#ifdef ENGINE_DEBUG
+    // Egy figyelt program a fájlfigyelő jobban. A bemenetet a fő szál tölti
+    // ki indítás előtt, a kimenetet csak a job befejezése után olvassa.
+    struct WatchedSource
+    {
+        std::size_t entry = 0;
+        std::filesystem::path vertexPath;
+        std::filesystem::path fragmentPath;
+        std::filesystem::file_time_type vertexWriteTime;
+        std::filesystem::file_time_type fragmentWriteTime;
+
+        bool changed = false;
+        bool readSucceeded = false;
+        std::string vertexSource;
+        std::string fragmentSource;
+    };
+
+    // a JobSystem::Run a függvényre csak hivatkozik, ezért tag
+    struct WatchJob
+    {
+        ShaderLibrary* library = nullptr;
+
+        void operator()() const
+        {
+            library->WatchSources();
+        }
+    };
+
+    // a fájlfigyelő job törzse, munkaszálon fut
+    void WatchSources();
+#endif
+
+    bool ReadSources(Entry& entry, std::string& outVertexSource, std::string& outFragmentSource) const;
+    std::uint64_t MakeCacheKey(const std::string& vertexSource, const std::string& fragmentSource) const;
+    std::string GetCachePath(std::uint64_t cacheKey) const;
+
+    // 0, ha nincs érvényes bináris (hiányzik, sérült, vagy a driver elutasítja)
+    unsigned int LoadCachedProgram(std::uint64_t cacheKey) const;
+    void StoreCachedProgram(std::uint64_t cacheKey, unsigned int program) const;
+
+    PendingProgram StartProgram(std::size_t entry, const std::string& vertexSource, const std::string& fragmentSource, std::uint64_t cacheKey) const;
+    bool IsComplete(const PendingProgram& pending) const;
+
+    // A linkelés eredménye: siker esetén a program, hibánál (a naplók kiírása után) 0
+    unsigned int FinishProgram(const PendingProgram& pending) const;
+
+private:
+    JobSystem& jobs;
+
+    std::string shaderDirectory;
+    std::string cacheDirectory;
+
+    std::string driverId; // vendor, renderer, verzió: driverfrissítés után új kulcs
+    bool binaryCacheSupported = false;
+    bool parallelCompileSupported = false;
+
+    std::vector<Entry> entries;
+    std::vector<PendingProgram> pending;
+
+    bool loadFailed = false;
+    int cacheHitCount = 0;
+
+#ifdef ENGINE_DEBUG
+    std::vector<PendingProgram> reloads;
+    std::chrono::steady_clock::time_point nextWatchTime;
+
+    std::vector<WatchedSource> watchedSources;
+    JobCounter watchCounter;
+    WatchJob watchJob{ this };
+    bool watchRunning = false;
+#endif
+};
\ No newline at end of file
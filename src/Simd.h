@@ -0,0 +1,22 @@
+#pragma once
+
+// x86 SIMD támogatás a batch kerneleknek. A futás közbeni választás a
+// CollisionBatch.h GetSimdLevel függvényén keresztül történik.
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define ZS_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC-n az intrinsicek külön fordítási kapcsoló nélkül is használhatók,
+// GCC/Clang alatt függvényenként kell engedélyezni az utasításkészletet.
+#if defined(ZS_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define ZS_TARGET_SSE2 __attribute__((target("sse2")))
+#define ZS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define ZS_TARGET_SSE2
+#define ZS_TARGET_AVX2
+#endif
\ No newline at end of file
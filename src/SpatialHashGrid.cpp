@@ -0,0 +1,184 @@
+#include "SpatialHashGrid.h"
+#include "Entity.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialHashGrid::SpatialHashGrid(float cellSize)
+    : cellSize(cellSize),
+    inverseCellSize(1.0f / cellSize)
+{
+}
+
+float SpatialHashGrid::GetCellSize() const
+{
+    return cellSize;
+}
+
+glm::ivec3 SpatialHashGrid::ToCell(const glm::vec3& point) const
+{
+    return
+    {
+        static_cast<int>(std::floor(point.x * inverseCellSize)),
+        static_cast<int>(std::floor(point.y * inverseCellSize)),
+        static_cast<int>(std::floor(point.z * inverseCellSize))
+    };
+}
+
+std::uint64_t SpatialHashGrid::PackCell(int x, int y, int z)
+{
+    // 21 bit tengelyenként, ez +-1 millió cellát fed le ütközés nélkül
+    constexpr std::uint64_t Mask = (1ull << 21) - 1;
+
+    return
+        (static_cast<std::uint64_t>(x) & Mask) |
+        ((static_cast<std::uint64_t>(y) & Mask) << 21) |
+        ((static_cast<std::uint64_t>(z) & Mask) << 42);
+}
+
+void SpatialHashGrid::Insert(Entity* entity)
+{
+    if (proxyLookup.find(entity) != proxyLookup.end())
+    {
+        Update(entity);
+        return;
+    }
+
+    std::uint32_t proxyIndex;
+
+    if (!freeProxies.empty())
+    {
+        proxyIndex = freeProxies.back();
+        freeProxies.pop_back();
+    }
+    else
+    {
+        proxyIndex = static_cast<std::uint32_t>(proxies.size());
+        proxies.emplace_back();
+    }
+
+    Proxy& proxy = proxies[proxyIndex];
+    proxy.entity = entity;
+    proxy.bounds = GetWorldAABB(*entity);
+    proxy.queryStamp = 0;
+
+    proxyLookup[entity] = proxyIndex;
+
+    AddToCells(proxyIndex);
+}
+
+void SpatialHashGrid::Update(Entity* entity)
+{
+    auto it = proxyLookup.find(entity);
+    if (it == proxyLookup.end())
+        return;
+
+    Proxy& proxy = proxies[it->second];
+    proxy.bounds = GetWorldAABB(*entity);
+
+    // ha ugyanazokat a cellákat fedi le, nincs mit átrendezni
+    if (!proxy.oversized &&
+        ToCell(proxy.bounds.min) == proxy.cellMin &&
+        ToCell(proxy.bounds.max) == proxy.cellMax)
+    {
+        return;
+    }
+
+    RemoveFromCells(it->second);
+    AddToCells(it->second);
+}
+
+void SpatialHashGrid::Remove(Entity* entity)
+{
+    auto it = proxyLookup.find(entity);
+    if (it == proxyLookup.end())
+        return;
+
+    const std::uint32_t proxyIndex = it->second;
+
+    RemoveFromCells(proxyIndex);
+
+    proxies[proxyIndex].entity = nullptr;
+    freeProxies.push_back(proxyIndex);
+    proxyLookup.erase(it);
+}
+
+void SpatialHashGrid::Clear()
+{
+    cells.clear();
+    proxyLookup.clear();
+    proxies.clear();
+    freeProxies.clear();
+    oversizedProxies.clear();
+}
+
+void SpatialHashGrid::AddToCells(std::uint32_t proxyIndex)
+{
+    Proxy& proxy = proxies[proxyIndex];
+
+    proxy.cellMin = ToCell(proxy.bounds.min);
+    proxy.cellMax = ToCell(proxy.bounds.max);
+
+    const glm::ivec3 span = proxy.cellMax - proxy.cellMin + glm::ivec3(1);
+    const long long cellCount =
+        static_cast<long long>(span.x) * span.y * span.z;
+
+    proxy.oversized = cellCount > MaxCellsPerProxy;
+
+    if (proxy.oversized)
+    {
+        oversizedProxies.push_back(proxyIndex);
+        return;
+    }
+
+    for (int x = proxy.cellMin.x; x <= proxy.cellMax.x; ++x)
+    {
+        for (int y = proxy.cellMin.y; y <= proxy.cellMax.y; ++y)
+        {
+            for (int z = proxy.cellMin.z; z <= proxy.cellMax.z; ++z)
+            {
+                cells[PackCell(x, y, z)].push_back(proxyIndex);
+            }
+        }
+    }
+}
+
+void SpatialHashGrid::RemoveFromCells(std::uint32_t proxyIndex)
+{
+    const Proxy& proxy = proxies[proxyIndex];
+
+    if (proxy.oversized)
+    {
+        auto it = std::find(oversizedProxies.begin(), oversizedProxies.end(), proxyIndex);
+        if (it != oversizedProxies.end())
+        {
+            *it = oversizedProxies.back();
+            oversizedProxies.pop_back();
+        }
+        return;
+    }
+
+    for (int x = proxy.cellMin.x; x <= proxy.cellMax.x; ++x)
+    {
+        for (int y = proxy.cellMin.y; y <= proxy.cellMax.y; ++y)
+        {
+            for (int z = proxy.cellMin.z; z <= proxy.cellMax.z; ++z)
+            {
+                auto cell = cells.find(PackCell(x, y, z));
+                if (cell == cells.end())
+                    continue;
+
+                std::vector<std::uint32_t>& bucket = cell->second;
+
+                auto it = std::find(bucket.begin(), bucket.end(), proxyIndex);
+                if (it != bucket.end())
+                {
+                    *it = bucket.back();
+                    bucket.pop_back();
+                }
+
+                // az üres vektort megtartjuk, így a visszatérő entitás nem foglal újra
+            }
+        }
+    }
+}
\ No newline at end of file
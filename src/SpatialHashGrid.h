@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/vec3.hpp>
+#include "AABB.h"
+#include "PlayerCollision.h"
+
+struct Entity;
+
+// Egyenletes cellákra osztott broadphase. Az entitások a ComputeWorldAABB
+// által lefedett cellákba kerülnek, a lekérdezés csak ezeket a cellákat nézi.
+class SpatialHashGrid
+{
+public:
+    explicit SpatialHashGrid(float cellSize);
+
+    void Insert(Entity* entity);
+    void Update(Entity* entity);
+    void Remove(Entity* entity);
+    void Clear();
+
+    // A callback minden átfedő jelöltre pontosan egyszer hívódik:
+    // bool callback(Entity* entity, const AABB& bounds), false -> leállás.
+    // Nem foglal memóriát.
+    template <typename Callback>
+    void QueryAABB(const AABB& box, Callback&& callback) const;
+
+    float GetCellSize() const;
+
+private:
+    // Ennél több cellát lefedő entitás (pl. talaj) külön listába kerül
+    static constexpr int MaxCellsPerProxy = 64;
+
+    struct Proxy
+    {
+        Entity* entity = nullptr;
+        AABB bounds{};
+        glm::ivec3 cellMin{ 0 };
+        glm::ivec3 cellMax{ 0 };
+        bool oversized = false;
+        mutable std::uint32_t queryStamp = 0;
+    };
+
+    glm::ivec3 ToCell(const glm::vec3& point) const;
+    static std::uint64_t PackCell(int x, int y, int z);
+
+    void AddToCells(std::uint32_t proxyIndex);
+    void RemoveFromCells(std::uint32_t proxyIndex);
+
+private:
+    float cellSize;
+    float inverseCellSize;
+
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> cells;
+    std::unordered_map<const Entity*, std::uint32_t> proxyLookup;
+
+    std::vector<Proxy> proxies;
+    std::vector<std::uint32_t> freeProxies;
+    std::vector<std::uint32_t> oversizedProxies;
+
+    mutable std::uint32_t currentQueryStamp = 0;
+};
+
+template <typename Callback>
+void SpatialHashGrid::QueryAABB(const AABB& box, Callback&& callback) const
+{
+    const std::uint32_t stamp = ++currentQueryStamp;
+
+    for (std::uint32_t proxyIndex : oversizedProxies)
+    {
+        const Proxy& proxy = proxies[proxyIndex];
+
+        if (!IntersectAABBvsAABB(proxy.bounds, box))
+            continue;
+
+        if (!callback(proxy.entity, proxy.bounds))
+            return;
+    }
+
+    const glm::ivec3 cellMin = ToCell(box.min);
+    const glm::ivec3 cellMax = ToCell(box.max);
+
+    for (int x = cellMin.x; x <= cellMax.x; ++x)
+    {
+        for (int y = cellMin.y; y <= cellMax.y; ++y)
+        {
+            for (int z = cellMin.z; z <= cellMax.z; ++z)
+            {
+                auto it = cells.find(PackCell(x, y, z));
+                if (it == cells.end())
+                    continue;
+
+                for (std::uint32_t proxyIndex : it->second)
+                {
+                    const Proxy& proxy = proxies[proxyIndex];
+
+                    // több cellában is szerepelhet, csak egyszer adjuk vissza
+                    if (proxy.queryStamp == stamp)
+                        continue;
+
+                    proxy.queryStamp = stamp;
+
+                    if (!IntersectAABBvsAABB(proxy.bounds, box))
+                        continue;
+
+                    if (!callback(proxy.entity, proxy.bounds))
+                        return;
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
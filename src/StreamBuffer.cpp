@@ -0,0 +1,131 @@
+#include "StreamBuffer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <glad/glad.h>
+
+namespace
+{
+    // egy várakozás legfeljebb ennyi (ns); utána újra próbáljuk, de szólunk
+    constexpr GLuint64 FenceWaitTimeout = 100'000'000;
+}
+
+StreamBuffer::StreamBuffer(std::size_t frameSize)
+    : frameSize(frameSize)
+{
+    GLint alignment = 0;
+
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    uniformAlignment = std::max<std::size_t>(alignment, 16);
+
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    storageAlignment = std::max<std::size_t>(alignment, 16);
+
+    // a részek eleje mindkét igazításnak megfelel (kettő hatványai)
+    const std::size_t frameAlignment = std::max(uniformAlignment, storageAlignment);
+    this->frameSize = (frameSize + frameAlignment - 1) / frameAlignment * frameAlignment;
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const GLsizeiptr totalSize = static_cast<GLsizeiptr>(this->frameSize * FrameCount);
+
+    glCreateBuffers(1, &buffer);
+    glNamedBufferStorage(buffer, totalSize, nullptr, flags);
+    mapped = static_cast<std::byte*>(glMapNamedBufferRange(buffer, 0, totalSize, flags));
+
+    if (mapped == nullptr)
+        std::cerr << "Stream buffer mapping failed\n";
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    for (void* fence : fences)
+    {
+        if (fence != nullptr)
+            glDeleteSync(static_cast<GLsync>(fence));
+    }
+
+    glUnmapNamedBuffer(buffer);
+    glDeleteBuffers(1, &buffer);
+}
+
+void StreamBuffer::BeginFrame()
+{
+    frameIndex = (frameIndex + 1) % FrameCount;
+
+    GLsync fence = static_cast<GLsync>(fences[frameIndex]);
+
+    if (fence != nullptr)
+    {
+        // a GPU FrameCount képkockával lemaradva: ritka, de ilyenkor meg kell várni
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceWaitTimeout);
+
+        while (result == GL_TIMEOUT_EXPIRED)
+        {
+            std::cerr << "Stream buffer: waiting for the GPU\n";
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceWaitTimeout);
+        }
+
+        glDeleteSync(fence);
+        fences[frameIndex] = nullptr;
+    }
+
+    frameOffset.store(0, std::memory_order_relaxed);
+}
+
+void StreamBuffer::EndFrame()
+{
+    fences[frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+StreamAllocation StreamBuffer::Allocate(std::size_t size, std::size_t alignment)
+{
+    if (mapped == nullptr)
+        return {};
+
+    const std::size_t frameStart = static_cast<std::size_t>(frameIndex) * frameSize;
+
+    std::size_t offset = frameOffset.load(std::memory_order_relaxed);
+    std::size_t aligned;
+
+    // CAS-os bump pointer: az igazítás miatt a fetch_add nem elég
+    do
+    {
+        aligned = (frameStart + offset + alignment - 1) / alignment * alignment - frameStart;
+
+        if (aligned + size > frameSize)
+        {
+            if (!overflowReported.exchange(true))
+                std::cerr << "Stream buffer is full (" << frameSize << " bytes per frame)\n";
+
+            return {};
+        }
+    }
+    while (!frameOffset.compare_exchange_weak(offset, aligned + size, std::memory_order_relaxed));
+
+    return { mapped + frameStart + aligned, frameStart + aligned, size };
+}
+
+unsigned int StreamBuffer::GetBuffer() const
+{
+    return buffer;
+}
+
+std::size_t StreamBuffer::GetUniformAlignment() const
+{
+    return uniformAlignment;
+}
+
+std::size_t StreamBuffer::GetStorageAlignment() const
+{
+    return storageAlignment;
+}
+
+std::size_t StreamBuffer::GetFrameUsage() const
+{
+    return frameOffset.load(std::memory_order_relaxed);
+}
+
+std::size_t StreamBuffer::GetFrameSize() const
+{
+    return frameSize;
+}
\ No newline at end of file
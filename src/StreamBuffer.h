@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Egy foglalás a stream bufferben: a data a leképezett memória (ide közvetlenül
+// lehet írni), az offset ugyanez a GL buffer elejétől (ezt kapja a GL hívás)
+struct StreamAllocation
+{
+    std::byte* data = nullptr;
+    std::size_t offset = 0;
+    std::size_t size = 0;
+
+    bool IsValid() const
+    {
+        return data != nullptr;
+    }
+};
+
+// Képkockánként változó adatok (instance adat, uniformok, indirect parancsok)
+// gyűrűs buffere persistent + coherent leképezéssel. A buffer FrameCount
+// egyforma részből áll: a képkocka a saját részébe ír, és a BeginFrame csak
+// akkor adja vissza egy rész használatát, ha a GPU fence-e szerint a
+// FrameCount képkockával korábbi rajzolás már végzett vele.
+//
+// Az Allocate zármentes (atomikus bump pointer), munkaszálakból is hívható;
+// a BeginFrame/EndFrame csak a GL szálon.
+class StreamBuffer
+{
+public:
+    static constexpr int FrameCount = 3;
+
+    explicit StreamBuffer(std::size_t frameSize);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // A következő rész várakozás után (ha a GPU még olvassa); a foglalások innen indulnak
+    void BeginFrame();
+
+    // Fence a képkocka utolsó parancsa után; a swap előtt hívandó
+    void EndFrame();
+
+    // alignment: kettő hatványa. Ha a rész betelt, érvénytelen foglalást ad.
+    StreamAllocation Allocate(std::size_t size, std::size_t alignment);
+
+    unsigned int GetBuffer() const;
+
+    // A GL által megkövetelt offset igazítások (glBindBufferRange)
+    std::size_t GetUniformAlignment() const;
+    std::size_t GetStorageAlignment() const;
+
+    // az aktuális képkocka eddigi foglalása bájtban
+    std::size_t GetFrameUsage() const;
+    std::size_t GetFrameSize() const;
+
+private:
+    unsigned int buffer = 0;
+    std::byte* mapped = nullptr;
+
+    std::size_t frameSize;
+    int frameIndex = 0;
+    std::atomic<std::size_t> frameOffset{ 0 }; // a rész elejétől
+    std::atomic<bool> overflowReported{ false };
+
+    void* fences[FrameCount] = {}; // GLsync, a glad ne kerüljön a headerbe
+
+    std::size_t uniformAlignment = 256;
+    std::size_t storageAlignment = 256;
+};
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include "SystemScheduler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+    bool Overlaps(const std::vector<const void*>& a, const std::vector<const void*>& b)
+    {
+        for (const void* resource : a)
+        {
+            if (std::find(b.begin(), b.end(), resource) != b.end())
+                return true;
+        }
+
+        return false;
+    }
+
+#ifdef ENGINE_DEBUG
+    constexpr int TimelineWidth = 40; // karakter a képkocka teljes idejére
+#endif
+}
+
+// ---- SystemAccess ----
+
+SystemAccess& SystemAccess::Read(const void* resource)
+{
+    readResources.push_back(resource);
+    return *this;
+}
+
+SystemAccess& SystemAccess::Write(const void* resource)
+{
+    writeResources.push_back(resource);
+    return *this;
+}
+
+SystemAccess& SystemAccess::MainThread()
+{
+    mainThread = true;
+    return *this;
+}
+
+bool SystemAccess::ConflictsWith(const SystemAccess& other) const
+{
+    if ((writeComponents & (other.readComponents | other.writeComponents)) != 0 ||
+        (other.writeComponents & readComponents) != 0)
+        return true;
+
+    return
+        Overlaps(writeResources, other.readResources) ||
+        Overlaps(writeResources, other.writeResources) ||
+        Overlaps(other.writeResources, readResources);
+}
+
+// ---- SystemScheduler ----
+
+SystemScheduler::SystemScheduler(JobSystem& jobs)
+    : jobs(jobs)
+{
+}
+
+void SystemScheduler::Add(const std::string& name, const SystemAccess& access, SystemFunction function)
+{
+    auto system = std::make_unique<System>();
+    system->name = name;
+    system->access = access;
+    system->function = std::move(function);
+
+    systems.push_back(std::move(system));
+
+    // a rendszerek címe stabil, a taskok újraépíthetők
+    tasks.clear();
+    for (std::uint32_t i = 0; i < systems.size(); ++i)
+    {
+        tasks.push_back({ this, i });
+    }
+
+    mainThreadReady.reserve(systems.size());
+}
+
+std::size_t SystemScheduler::GetSystemCount() const
+{
+    return systems.size();
+}
+
+void SystemScheduler::BuildGraph()
+{
+    for (const std::unique_ptr<System>& system : systems)
+    {
+        system->successors.clear();
+        system->predecessorCount = 0;
+    }
+
+    // A közvetett függőségek élei is bekerülnek, ez néhány tucat rendszernél
+    // olcsóbb, mint a gráf ritkítása
+    for (std::uint32_t i = 0; i < systems.size(); ++i)
+    {
+        for (std::uint32_t j = i + 1; j < systems.size(); ++j)
+        {
+            if (systems[i]->access.ConflictsWith(systems[j]->access))
+            {
+                systems[i]->successors.push_back(j);
+                ++systems[j]->predecessorCount;
+            }
+        }
+    }
+}
+
+void SystemScheduler::Run()
+{
+    if (systems.empty())
+        return;
+
+    BuildGraph();
+
+#ifdef ENGINE_DEBUG
+    runStart = std::chrono::steady_clock::now();
+#endif
+
+    remainingSystems.store(static_cast<int>(systems.size()), std::memory_order_relaxed);
+
+    for (const std::unique_ptr<System>& system : systems)
+    {
+        system->pendingPredecessors.store(system->predecessorCount, std::memory_order_relaxed);
+    }
+
+    for (std::uint32_t i = 0; i < systems.size(); ++i)
+    {
+        if (systems[i]->predecessorCount == 0)
+            Dispatch(i);
+    }
+
+    // a fő szál a hozzá kötött rendszereket futtatja, közben besegít a jobokba
+    while (remainingSystems.load(std::memory_order_acquire) > 0)
+    {
+        std::uint32_t index = 0;
+        bool found = false;
+
+        {
+            std::lock_guard<std::mutex> lock(mainThreadMutex);
+
+            if (!mainThreadReady.empty())
+            {
+                index = mainThreadReady.back();
+                mainThreadReady.pop_back();
+                found = true;
+            }
+        }
+
+        if (found)
+        {
+            Execute(index);
+        }
+        else if (!jobs.RunPendingJob())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // a jobok a rendszer után még csökkentik a számlálót
+    jobs.Wait(jobCounter);
+
+#ifdef ENGINE_DEBUG
+    runEnd = std::chrono::steady_clock::now();
+#endif
+}
+
+void SystemScheduler::Dispatch(std::uint32_t index)
+{
+    if (systems[index]->access.mainThread)
+    {
+        std::lock_guard<std::mutex> lock(mainThreadMutex);
+        mainThreadReady.push_back(index);
+    }
+    else
+    {
+        jobs.Run(jobCounter, tasks[index]);
+    }
+}
+
+void SystemScheduler::Execute(std::uint32_t index)
+{
+    System& system = *systems[index];
+
+#ifdef ENGINE_DEBUG
+    system.thread = jobs.GetCurrentThreadIndex();
+    system.start = std::chrono::steady_clock::now();
+#endif
+
+    system.function();
+
+#ifdef ENGINE_DEBUG
+    system.end = std::chrono::steady_clock::now();
+#endif
+
+    for (std::uint32_t successor : system.successors)
+    {
+        if (systems[successor]->pendingPredecessors.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Dispatch(successor);
+    }
+
+    remainingSystems.fetch_sub(1, std::memory_order_release);
+}
+
+#ifdef ENGINE_DEBUG
+
+void SystemScheduler::PrintTimeline() const
+{
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    const double total = std::max(Milliseconds(runEnd - runStart).count(), 1e-6);
+
+    std::size_t nameWidth = 0;
+    for (const std::unique_ptr<System>& system : systems)
+    {
+        nameWidth = std::max(nameWidth, system->name.size());
+    }
+
+    std::cout
+        << "System timeline (" << systems.size() << " systems, "
+        << jobs.GetThreadCount() << " threads, " << total << " ms)\n"
+        << std::fixed << std::setprecision(3);
+
+    for (std::uint32_t i = 0; i < systems.size(); ++i)
+    {
+        const System& system = *systems[i];
+
+        const double start = Milliseconds(system.start - runStart).count();
+        const double end = Milliseconds(system.end - runStart).count();
+
+        const int first = std::clamp(static_cast<int>(start / total * TimelineWidth), 0, TimelineWidth - 1);
+        const int last = std::clamp(static_cast<int>(end / total * TimelineWidth), first, TimelineWidth - 1);
+
+        std::string bar(TimelineWidth, ' ');
+        std::fill(bar.begin() + first, bar.begin() + last + 1, '#');
+
+        std::cout
+            << "  " << std::left << std::setw(static_cast<int>(nameWidth)) << system.name << std::right
+            << " [" << bar << "] thread " << system.thread << ", "
+            << start << " - " << end << " ms";
+
+        // elődök: a korábbi rendszerek, amelyek utódai között szerepel
+        const char* separator = ", after ";
+        for (std::uint32_t j = 0; j < i; ++j)
+        {
+            const std::vector<std::uint32_t>& successors = systems[j]->successors;
+
+            if (std::find(successors.begin(), successors.end(), i) != successors.end())
+            {
+                std::cout << separator << systems[j]->name;
+                separator = ", ";
+            }
+        }
+
+        std::cout << "\n";
+    }
+
+    std::cout << "  overlapped:";
+
+    bool anyOverlap = false;
+    for (std::uint32_t i = 0; i < systems.size(); ++i)
+    {
+        for (std::uint32_t j = i + 1; j < systems.size(); ++j)
+        {
+            if (systems[i]->start < systems[j]->end && systems[j]->start < systems[i]->end)
+            {
+                std::cout << (anyOverlap ? ", " : " ") << systems[i]->name << " | " << systems[j]->name;
+                anyOverlap = true;
+            }
+        }
+    }
+
+    std::cout << (anyOverlap ? "\n" : " none\n") << std::defaultfloat << std::setprecision(6);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Ecs.h"
+#include "JobSystem.h"
+
+// Egy rendszer által olvasott és írt adatok. Az ECS komponenseket típus
+// szerint, a többi állapotot (kamera, ütközési világ, entitás lista) a
+// címével adjuk meg; egy konténer a teljes tartalmát képviseli. Két rendszer
+// ütközik, ha valamelyik írja azt, amit a másik olvas vagy ír.
+struct SystemAccess
+{
+    ComponentMask readComponents = 0;
+    ComponentMask writeComponents = 0;
+
+    std::vector<const void*> readResources;
+    std::vector<const void*> writeResources;
+
+    // GLFW bemenet és GL hívások: csak a fő szálon futhat
+    bool mainThread = false;
+
+    template <typename... Components>
+    SystemAccess& ReadComponents()
+    {
+        readComponents |= MakeComponentMask<Components...>();
+        return *this;
+    }
+
+    template <typename... Components>
+    SystemAccess& WriteComponents()
+    {
+        writeComponents |= MakeComponentMask<Components...>();
+        return *this;
+    }
+
+    SystemAccess& Read(const void* resource);
+    SystemAccess& Write(const void* resource);
+    SystemAccess& MainThread();
+
+    bool ConflictsWith(const SystemAccess& other) const;
+};
+
+// A képkocka rendszereinek ütemezője. A Run minden képkockán felépíti a
+// függőségi gráfot: két ütköző rendszer közül a korábban hozzáadott fut
+// előbb (ez a régi, kézi sorrend), a nem ütközők párhuzamosan futhatnak.
+// A kész rendszer indítja azokat az utódait, amelyeknek minden elődje kész;
+// a fő szálhoz kötötteket a Run hívója futtatja, közben jobokat is végez.
+class SystemScheduler
+{
+public:
+    using SystemFunction = std::function<void()>;
+
+    explicit SystemScheduler(JobSystem& jobs);
+
+    SystemScheduler(const SystemScheduler&) = delete;
+    SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+    // Induláskor, a hozzáadás sorrendje az ütközők sorrendje
+    void Add(const std::string& name, const SystemAccess& access, SystemFunction function);
+
+    // Csak a fő szálról; visszatéréskor minden rendszer lefutott
+    void Run();
+
+    std::size_t GetSystemCount() const;
+
+#ifdef ENGINE_DEBUG
+    // Az utolsó Run idővonala: rendszerenként szál, kezdet, vég, elődök,
+    // és mely rendszerek futottak egymással átfedésben
+    void PrintTimeline() const;
+#endif
+
+private:
+    struct System
+    {
+        std::string name;
+        SystemAccess access;
+        SystemFunction function;
+
+        std::vector<std::uint32_t> successors;
+        int predecessorCount = 0;
+        std::atomic<int> pendingPredecessors{ 0 };
+
+#ifdef ENGINE_DEBUG
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point end;
+        int thread = 0;
+#endif
+    };
+
+    // a JobSystem::Run a függvényre hivatkozik, ezért rendszerenként egy állandó példány
+    struct SystemTask
+    {
+        SystemScheduler* scheduler = nullptr;
+        std::uint32_t index = 0;
+
+        void operator()() const
+        {
+            scheduler->Execute(index);
+        }
+    };
+
+    void BuildGraph();
+    void Dispatch(std::uint32_t index);
+    void Execute(std::uint32_t index);
+
+private:
+    JobSystem& jobs;
+
+    std::vector<std::unique_ptr<System>> systems;
+    std::vector<SystemTask> tasks;
+
+    JobCounter jobCounter;
+    std::atomic<int> remainingSystems{ 0 };
+
+    // a fő szálhoz kötött, indítható rendszerek
+    std::mutex mainThreadMutex;
+    std::vector<std::uint32_t> mainThreadReady;
+
+#ifdef ENGINE_DEBUG
+    std::chrono::steady_clock::time_point runStart;
+    std::chrono::steady_clock::time_point runEnd;
+#endif
+};
\ No newline at end of file
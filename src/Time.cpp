@@ -2,17 +2,27 @@
 
 #include <GLFW/glfw3.h>
 
-float Time::deltaTime = 0.0f;
-float Time::lastFrameTime = 0.0f;
+double Time::deltaTime = 0.0;
+double Time::lastFrameTime = 0.0;
 
 void Time::Update()
 {
-    float currentTime = static_cast<float>(glfwGetTime());
+    double currentTime = glfwGetTime();
     deltaTime = currentTime - lastFrameTime;
     lastFrameTime = currentTime;
 }
 
 float Time::GetDeltaTime()
+{
+    return static_cast<float>(deltaTime);
+}
+
+double Time::GetDeltaTimeDouble()
 {
     return deltaTime;
+}
+
+double Time::GetTime()
+{
+    return lastFrameTime;
 }
\ No newline at end of file
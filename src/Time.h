@@ -1,12 +1,20 @@
 #pragma once
 
+// Képkocka idő. A glfwGetTime monoton órát használ; double-ben tároljuk,
+// hogy hosszú futás után se veszítsen pontosságot.
 class Time
 {
 public:
     static void Update();
+
+    // az előző képkocka óta eltelt idő másodpercben
     static float GetDeltaTime();
+    static double GetDeltaTimeDouble();
+
+    // az indulás óta eltelt idő másodpercben
+    static double GetTime();
 
 private:
-    static float deltaTime;
-    static float lastFrameTime;
+    static double deltaTime;
+    static double lastFrameTime;
 };
\ No newline at end of file
@@ -33,4 +33,26 @@ glm::mat4 Transform::GetModelMatrix() const
     model = glm::scale(model, scale);
 
     return model;
+}
+
+glm::mat3 Transform::GetRotationMatrix() const
+{
+    glm::mat4 rotation = glm::mat4(1.0f);
+
+    rotation = glm::rotate(rotation, glm::radians(rotationDegrees.x), glm::vec3(1.0f, 0.0f, 0.0f));
+    rotation = glm::rotate(rotation, glm::radians(rotationDegrees.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    rotation = glm::rotate(rotation, glm::radians(rotationDegrees.z), glm::vec3(0.0f, 0.0f, 1.0f));
+
+    return glm::mat3(rotation);
+}
+
+Transform InterpolateTransform(const Transform& previous, const Transform& current, float alpha)
+{
+    Transform result;
+
+    result.position = glm::mix(previous.position, current.position, alpha);
+    result.rotationDegrees = glm::mix(previous.rotationDegrees, current.rotationDegrees, alpha);
+    result.scale = glm::mix(previous.scale, current.scale, alpha);
+
+    return result;
 }
\ No newline at end of file
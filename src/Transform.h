@@ -12,4 +12,10 @@ struct Transform
     Transform();
 
     glm::mat4 GetModelMatrix() const;
-};
\ No newline at end of file
+
+    // ugyanaz a forgatási sorrend, mint a GetModelMatrix-ban (X, Y, Z)
+    glm::mat3 GetRotationMatrix() const;
+};
+
+// Lineáris interpoláció két szimulációs állapot között (alpha: 0 -> previous, 1 -> current)
+Transform InterpolateTransform(const Transform& previous, const Transform& current, float alpha);
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "UniformBuffer.h"
+#include "StreamBuffer.h"
+
+#include <cstring>
+#include <glad/glad.h>
+
+UniformBuffer::UniformBuffer(StreamBuffer& stream, std::size_t size, unsigned int bindingPoint)
+    : stream(stream),
+    size(size),
+    bindingPoint(bindingPoint)
+{
+}
+
+bool UniformBuffer::Update(const void* data)
+{
+    StreamAllocation allocation = stream.Allocate(size, stream.GetUniformAlignment());
+    if (!allocation.IsValid())
+        return false;
+
+    std::memcpy(allocation.data, data, size);
+
+    glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, stream.GetBuffer(), static_cast<GLintptr>(allocation.offset), static_cast<GLsizeiptr>(size));
+
+    return true;
+}
+
+unsigned int UniformBuffer::GetBindingPoint() const
+{
+    return bindingPoint;
+}
\ No newline at end of file
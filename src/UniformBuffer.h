@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <glm/mat4x4.hpp>
+
+class StreamBuffer;
+
+// Az összes shader által közösen használt, képkockánként egyszer frissített adatok.
+// std140 elrendezés: a GLSL oldali FrameData blokkal egyeznie kell.
+struct FrameUniformData
+{
+    glm::mat4 view;
+    glm::mat4 projection;
+};
+
+constexpr unsigned int FrameUniformBinding = 0;
+constexpr const char* FrameUniformBlockName = "FrameData";
+
+// Uniform blokk egy rögzített binding pointon. Saját buffere nincs: minden
+// Update a stream buffer képkockánkénti részébe ír, és oda köti a binding pointot,
+// így a GPU által még olvasott előző tartalmat nem kell megvárni.
+class UniformBuffer
+{
+public:
+    UniformBuffer(StreamBuffer& stream, std::size_t size, unsigned int bindingPoint);
+
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+    // A teljes blokkot írja (size bájt); false, ha a stream buffer betelt
+    bool Update(const void* data);
+
+    unsigned int GetBindingPoint() const;
+
+private:
+    StreamBuffer& stream;
+    std::size_t size;
+    unsigned int bindingPoint;
+};
\ No newline at end of file
@@ -1,65 +1,79 @@
 ﻿#include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 #include "Camera.h"
 #include "Input.h"
 #include "Time.h"
+#include "FixedTimestep.h"
+#include "JobSystem.h"
+#include "JobBenchmark.h"
+#include "FrameArena.h"
+#include "SystemScheduler.h"
 #include "Transform.h"
 
 #include "Entity.h"
+#include "Ecs.h"
+#include "EcsBenchmark.h"
+#include "Components.h"
 #include "AABB.h"
 #include "CollisionSystem.h"
 #include "CameraCollision.h"
 #include "PlayerCollision.h"
+#include "CollisionWorld.h"
+#include "CollisionBenchmark.h"
+#include "CollisionStats.h"
+#include "CharacterController.h"
 
 #include "Shader.h"
+#include "ShaderLibrary.h"
+#include "StreamBuffer.h"
+#include "UniformBuffer.h"
 #include "Mesh.h"
+#include "MeshData.h"
+#include "MeshBenchmark.h"
+#include "MeshOptimizer.h"
+#include "InstancedRenderer.h"
+#include "RenderQueue.h"
+#include "GpuDrivenRenderer.h"
+#include "RenderVerification.h"
+#include "FrustumCulling.h"
+#include "OcclusionCulling.h"
 #include <glm/gtc/matrix_transform.hpp>
 
-static const char* VertexShaderSource = R"(
-#version 460 core
-
-layout (location = 0) in vec3 aPosition;
-layout (location = 1) in vec3 aColor;
-
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-out vec3 vColor;
-
-void main()
+namespace
 {
-    vColor = aColor;
-    gl_Position = projection * view * model * vec4(aPosition, 1.0);
-}
-)";
-
-static const char* FragmentShaderSource = R"(
-#version 460 core
-
-in vec3 vColor;
-
-uniform vec3 objectColor;
-uniform bool useVertexColor;
-
-out vec4 FragColor;
+    enum class RenderPath
+    {
+        Classic,   // RenderQueue -> rajzolás állapotonként
+        GpuDriven  // RenderQueue -> passonként egy multi-draw indirect
+    };
 
-void main()
-{
-    vec3 finalColor = useVertexColor ? vColor : objectColor;
-    FragColor = vec4(finalColor, 1.0);
-}
-)";
+    struct LaunchOptions
+    {
+        RenderPath renderPath = RenderPath::Classic;
+        bool verifyGpuDriven = false; // egy képkocka után összehasonlít és kilép
+    };
 
-namespace
-{
     constexpr int WindowWidth = 1920;
     constexpr int WindowHeight = 1080;
     constexpr const char* WindowTitle = "Zombie Survival";
 
+    constexpr const char* ModelDirectory = "assets/models";
+    constexpr const char* ShaderDirectory = "assets/shaders";
+    constexpr const char* ShaderCacheDirectory = "shader_cache"; // linkelt program binárisok
+
+    // képkockánként ennyi instance adat, uniform és indirect parancs fér a stream bufferbe
+    constexpr std::size_t StreamBufferFrameSize = 8 * 1024 * 1024;
+
+    // szálanként ennyi ideiglenes CPU memória képkockánként (csomagok, rendezés)
+    constexpr std::size_t FrameArenaSize = 4 * 1024 * 1024;
+
     constexpr float FieldOfViewDegrees = 70.0f;
     constexpr float NearClippingPlane = 0.1f;
     constexpr float FarClippingPlane = 100.0f;
@@ -72,11 +86,51 @@ namespace
     constexpr glm::vec3 WallColor1 = glm::vec3(1.0f, 0.6f, 0.0f);  // sárga
     constexpr glm::vec3 WallColor2 = glm::vec3(0.8f, 0.1f, 0.1f);  // vörös
 
+    constexpr float BroadphaseCellSize = 4.0f;
+
+    constexpr std::size_t RenderExtractGrainSize = 512; // jelölt / job a kinyerésnél
+
+    constexpr double SimulationTickRate = 60.0;
+    constexpr int MaxSimulationStepsPerFrame = 5; // akadás után ennyi lépést pótol
+
     constexpr float CameraHeight = 1.5f;
     constexpr float CameraRadius = 0.3f;
+    constexpr float CameraZoomOutSpeed = 6.0f;
 
     constexpr float MinDegree = -90.0f;
     constexpr float MaxDegree = 90.0f;
+
+#ifdef ENGINE_DEBUG
+    constexpr int StressCubesPerSide = 100; // 10k kocka a rajzolás méréséhez
+    constexpr double RenderReportInterval = 2.0;
+#endif
+}
+
+static bool ParseLaunchOptions(int argc, char** argv, LaunchOptions& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--gpu-driven") == 0)
+        {
+            options.renderPath = RenderPath::GpuDriven;
+        }
+        else if (std::strcmp(argv[i], "--verify-gpu-driven") == 0)
+        {
+#ifdef ENGINE_DEBUG
+            options.verifyGpuDriven = true;
+#else
+            std::cerr << "--verify-gpu-driven requires a debug build\n";
+            return false;
+#endif
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << argv[i] << "\n";
+            return false;
+        }
+    }
+
+    return true;
 }
 
 static bool InitializeGlfw()
@@ -127,8 +181,10 @@ static bool InitializeGlad()
     return true;
 }
 
-static void PlayerMovement(Entity& player, const std::vector<Entity*>& worldEntities, const Camera& camera, float playerMovementSpeed)
+static void PlayerMovement(Entity& player, CharacterController& controller, const CollisionWorld& world, const Camera& camera, float playerMovementSpeed, float deltaTime)
 {
+    ZS_COLLISION_TIMER(PlayerMovement);
+
     glm::vec3 forward =
     {
         camera.GetForwardDirection().x,
@@ -171,113 +227,100 @@ static void PlayerMovement(Entity& player, const std::vector<Entity*>& worldEnti
         movementDirection -= right;
     }
 
-    if (glm::length(movementDirection) == 0.0f)
+    if (glm::length(movementDirection) > 0.0f)
     {
-        return;
+        movementDirection = glm::normalize(movementDirection);
     }
 
-    movementDirection = glm::normalize(movementDirection);
-
-    glm::vec3 movement = movementDirection * playerMovementSpeed * Time::GetDeltaTime();
-
-    glm::vec3 newPosition = player.transform.position;
-
-    auto ComputePlayerCapsule = [&](const glm::vec3& position, glm::vec3& outBase, glm::vec3& outTip)
-    {
-        const float radius = player.collision.capsule.radius;
-        const float height = player.collision.capsule.height;
-
-        outBase = position + player.collision.localOffset + glm::vec3(0.0f, radius, 0.0f);
-
-        outTip = outBase + glm::vec3(0.0f, height - 2.0f * radius, 0.0f);
-    };
+    glm::vec3 movement = movementDirection * playerMovementSpeed * deltaTime;
 
-    // ---- X AXIS ----
-    if (movement.x != 0.0f)
-    {
-        glm::vec3 testPosition = newPosition;
-        testPosition.x += movement.x;
+    controller.Move(player, movement, deltaTime, world);
+}
 
-        glm::vec3 capsuleBase;
-        glm::vec3 capsuleTip;
+static int RunGameLoop(GLFWwindow* window, const LaunchOptions& options)
+{
+    int exitCode = 0;
 
-        ComputePlayerCapsule(testPosition, capsuleBase, capsuleTip);
+    float playerMovementSpeed = 10.0f;
 
-        bool collided = false;
+    Input::Initialize(window);
 
-        for (const Entity* e : worldEntities)
-        {
-            if (e == &player)
-                continue;
+    // munkaszálak a hardver szálszáma szerint, a fő szál várakozás közben besegít
+    JobSystem jobs;
 
-            if (e->collision.type != CollisionShape::Type::AABB)
-                continue;
+#ifdef ENGINE_DEBUG
+    auto shaderLoadStart = std::chrono::steady_clock::now();
+#endif
 
-            AABB box = ComputeWorldAABB(*e);
+    // a fordítások együtt indulnak, a Finish egyszerre várja meg őket
+    ShaderLibrary shaders(jobs, ShaderDirectory, ShaderCacheDirectory);
+    Shader& shader = shaders.Load("basic.vert", "basic.frag");
+    Shader& instancedShader = shaders.Load("instanced.vert", "instanced.frag");
+    Shader& gpuDrivenShader = shaders.Load("gpu_driven.vert", "instanced.frag");
 
-            if (IntersectCapsuleVsAABB(
-                capsuleBase,
-                capsuleTip,
-                player.collision.capsule.radius,
-                box))
-            {
-                collided = true;
-                break;
-            }
-        }
-
-        if (!collided)
-            newPosition.x = testPosition.x;
+    if (!shaders.Finish())
+    {
+        std::cerr << "Failed to load shaders from " << ShaderDirectory << "\n";
+        return -1;
     }
 
-    // ---- Z AXIS ----
-    if (movement.z != 0.0f)
-    {
-        glm::vec3 testPosition = newPosition;
-        testPosition.z += movement.z;
+#ifdef ENGINE_DEBUG
+    auto shaderLoadEnd = std::chrono::steady_clock::now();
 
-        glm::vec3 capsuleBase;
-        glm::vec3 capsuleTip;
+    std::cout
+        << "Shaders: " << shaders.GetProgramCount() << " programs, "
+        << shaders.GetCacheHitCount() << " from cache, "
+        << (shaders.IsParallelCompileSupported() ? "parallel" : "serial") << " compile, "
+        << std::chrono::duration<double, std::milli>(shaderLoadEnd - shaderLoadStart).count() << " ms\n";
+#endif
 
-        ComputePlayerCapsule(testPosition, capsuleBase, capsuleTip);
+    MeshData cubeData = MakeCubeMeshData();
+    OptimizeMesh(cubeData);
 
-        bool collided = false;
+    Mesh cube(cubeData);
 
-        for (const Entity* e : worldEntities)
-        {
-            if (e == &player)
-                continue;
+    // szálanként egy bump aréna, a képkocka elején ürül
+    FrameArena frameArena(jobs, FrameArenaSize);
 
-            if (e->collision.type != CollisionShape::Type::AABB)
-                continue;
+    // a képkockánként változó GPU adat közös, persistent-mapped gyűrűs buffere
+    StreamBuffer frameStream(StreamBufferFrameSize);
 
-            AABB box = ComputeWorldAABB(*e);
+    // view és projection a stream bufferben, képkockánként egyszer írva
+    UniformBuffer frameUniforms(frameStream, sizeof(FrameUniformData), FrameUniformBinding);
+    shader.BindUniformBlock(FrameUniformBlockName, FrameUniformBinding);
+    instancedShader.BindUniformBlock(FrameUniformBlockName, FrameUniformBinding);
+    gpuDrivenShader.BindUniformBlock(FrameUniformBlockName, FrameUniformBinding);
 
-            if (IntersectCapsuleVsAABB(capsuleBase, capsuleTip, player.collision.capsule.radius, box))
-            {
-                collided = true;
-                break;
-            }
-        }
+    InstancedRenderer renderer(frameStream);
 
-        if (!collided)
-            newPosition.z = testPosition.z;
-    }
+    // a csomagokat munkaszálak építik, rendezés után állapotonként egy rajzolás
+    RenderQueue renderQueue(jobs, frameArena);
+    const std::uint32_t instancedShaderId = renderQueue.RegisterShader(instancedShader);
+    const std::uint32_t gpuDrivenShaderId = renderQueue.RegisterShader(gpuDrivenShader);
+    const std::uint32_t cubeMeshId = renderQueue.RegisterMesh(cube);
 
-    player.transform.position = newPosition;
-}
+    // ugyanazok a meshek egy közös bufferben, a GPU-driven úthoz
+    GpuDrivenRenderer gpuRenderer(frameStream);
+    gpuRenderer.AddMesh(cubeMeshId, cubeData);
 
-static void RunGameLoop(GLFWwindow* window)
-{
-    float playerMovementSpeed = 10.0f;
+    RenderPath renderPath = options.renderPath;
 
-    Input::Initialize(window);
+    // csak kirajzolt entitások (nincsenek az ütközési világban), komponens oszlopokban
+    EcsWorld scene;
 
-    Shader shader(VertexShaderSource, FragmentShaderSource);
-    Mesh cube;
+    // a kirajzolás jelöltjei, a model mátrixuk és dobozuk a culling bemenete
+    std::vector<Renderable> renderCandidates;
+    std::vector<glm::mat4> renderModels;
+    AABBSoA renderBounds;
+    std::vector<std::uint32_t> visibleIndices;
+
+    // a statikus dobozok (falak, barikádok) takarják a mögöttük lévőket
+    OcclusionBuffer occlusionBuffer(jobs);
+    std::vector<std::uint32_t> visibleOccluders;
 
     Entity ground;
     ground.transform.position = glm::vec3(0.0f, 0.0f, 0.0f);
+    ground.mobility = Mobility::Static;
     ground.color = GroundColor;
     ground.useVertexColor = false;
     ground.collision.type = CollisionShape::Type::AABB;
@@ -293,6 +336,7 @@ static void RunGameLoop(GLFWwindow* window)
 
     Entity wallNorth;
     wallNorth.transform.position = glm::vec3(0.0f, WallHeight * 0.5f, ArenaSize * 0.5f - WallThickness * 0.5f);
+    wallNorth.mobility = Mobility::Static;
     wallNorth.color = WallColor1;
     wallNorth.useVertexColor = false;
     wallNorth.collision.type = CollisionShape::Type::AABB;
@@ -307,6 +351,7 @@ static void RunGameLoop(GLFWwindow* window)
 
     Entity wallSouth;
     wallSouth.transform.position = glm::vec3(0.0f, WallHeight * 0.5f, -ArenaSize * 0.5f + WallThickness * 0.5f);
+    wallSouth.mobility = Mobility::Static;
     wallSouth.color = WallColor1;
     wallSouth.useVertexColor = false;
     wallSouth.collision.type = CollisionShape::Type::AABB;
@@ -321,6 +366,7 @@ static void RunGameLoop(GLFWwindow* window)
 
     Entity wallEast;
     wallEast.transform.position = glm::vec3(ArenaSize * 0.5f - WallThickness * 0.5f, WallHeight * 0.5f, 0.0f);
+    wallEast.mobility = Mobility::Static;
     wallEast.color = WallColor2;
     wallEast.useVertexColor = false;
     wallEast.collision.type = CollisionShape::Type::AABB;
@@ -335,6 +381,7 @@ static void RunGameLoop(GLFWwindow* window)
 
     Entity wallWest;
     wallWest.transform.position = glm::vec3(-ArenaSize * 0.5f + WallThickness * 0.5f, WallHeight * 0.5f, 0.0f);
+    wallWest.mobility = Mobility::Static;
     wallWest.color = WallColor2;
     wallWest.useVertexColor = false;
     wallWest.collision.type = CollisionShape::Type::AABB;
@@ -352,7 +399,8 @@ static void RunGameLoop(GLFWwindow* window)
     centerCube.transform.scale = glm::vec3(1.0f);
     centerCube.color = glm::vec3(1.0f);
     centerCube.useVertexColor = true;
-    centerCube.collision.type = CollisionShape::Type::AABB;
+    centerCube.collision.type = CollisionShape::Type::OBB; // forog, a doboz követi
+    centerCube.mobility = Mobility::Dynamic;
     centerCube.collision.localOffset = glm::vec3(0.0f);
     centerCube.collision.halfExtents =
     {
@@ -386,41 +434,99 @@ static void RunGameLoop(GLFWwindow* window)
         &player
     };
 
+    CollisionWorld world(BroadphaseCellSize);
+
+    for (Entity* entity : worldEntities)
+    {
+        entity->previousTransform = entity->transform;
+        world.Add(entity);
+    }
+
+    FixedTimestep timestep(SimulationTickRate, MaxSimulationStepsPerFrame);
+    float interpolationAlpha = 0.0f;
+
+    CharacterController playerController;
+
     Camera camera(window);
 
     glm::vec3 pivot = player.transform.position + glm::vec3(0.0f, player.collision.capsule.height * 0.5f + CameraHeight, 0.0f);
 
     const float cameraDistance = player.collision.capsule.height * 0.5f + CameraHeight;
 
+    float smoothedCameraDistance = 0.0f;
+
     const float aspectRatio = static_cast<float>(WindowWidth) / static_cast<float>(WindowHeight);
 
-    auto DrawEntity = [&](const Entity& entity)
+    // a látható entitások csomagjai, kirajzolva a megadott úton
+    auto DrawVisible = [&](RenderPath path, const glm::mat4& view)
     {
-        glm::mat4 model = entity.transform.GetModelMatrix();
+        const std::uint32_t shaderId = path == RenderPath::GpuDriven ? gpuDrivenShaderId : instancedShaderId;
 
-        shader.SetMat4("model", model);
-        shader.SetVec3("objectColor", entity.color);
-        shader.SetBool("useVertexColor", entity.useVertexColor);
+        renderQueue.Begin();
 
-        cube.Draw();
+        renderQueue.Build(visibleIndices.size(), [&](std::size_t first, std::size_t last, RenderCommandList& commands)
+        {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                const std::uint32_t index = visibleIndices[i];
+                const Renderable& renderable = renderCandidates[index];
+                const glm::mat4& model = renderModels[index];
+
+                // a model középpontjának mélysége a nézet irányában
+                const float viewDepth = -(view * model[3]).z;
+                const std::uint64_t sortKey = MakeSortKey(RenderPass::Opaque, shaderId, cubeMeshId, 0, viewDepth / FarClippingPlane);
+
+                commands.Add(sortKey, model, renderable.color, renderable.useVertexColor);
+            }
+        });
+
+        if (path == RenderPath::GpuDriven)
+        {
+            renderQueue.ExecuteIndirect(gpuRenderer);
+        }
+        else
+        {
+            renderQueue.Execute(renderer);
+        }
     };
 
 #ifdef ENGINE_DEBUG
 
+    const UniformHandle modelUniform = shader.GetUniform("model");
+    const UniformHandle objectColorUniform = shader.GetUniform("objectColor");
+    const UniformHandle useVertexColorUniform = shader.GetUniform("useVertexColor");
+
+    // entitásonkénti rajzolás, a példányosított út összehasonlításához (Ctrl+N)
+    auto DrawEntity = [&](const Renderable& renderable, const glm::mat4& model)
+    {
+        shader.SetMat4(modelUniform, model);
+        shader.SetVec3(objectColorUniform, renderable.color);
+        shader.SetBool(useVertexColorUniform, renderable.useVertexColor);
+
+        cube.Draw();
+    };
+
     auto DrawCollisionAABB = [&](const Entity& entity)
     {
-        if (entity.collision.type != CollisionShape::Type::AABB)
+        if (entity.collision.type != CollisionShape::Type::AABB &&
+            entity.collision.type != CollisionShape::Type::OBB)
             return;
 
         Transform t;
         t.position = entity.transform.position + entity.collision.localOffset;
         t.scale = entity.collision.halfExtents * 2.0f;
 
+        if (entity.collision.type == CollisionShape::Type::OBB)
+        {
+            t.position = GetWorldOBB(entity).center;
+            t.rotationDegrees = entity.transform.rotationDegrees;
+        }
+
         glm::mat4 model = t.GetModelMatrix();
 
-        shader.SetMat4("model", model);
-        shader.SetVec3("objectColor", glm::vec3(0.48f, 0.99f, 0.0f));
-        shader.SetBool("useVertexColor", false);
+        shader.SetMat4(modelUniform, model);
+        shader.SetVec3(objectColorUniform, glm::vec3(0.48f, 0.99f, 0.0f));
+        shader.SetBool(useVertexColorUniform, false);
 
         glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
         cube.Draw();
@@ -446,20 +552,20 @@ static void RunGameLoop(GLFWwindow* window)
             t.position = position + glm::vec3(0.0f, radius + cylinderHeight * 0.5f, 0.0f);
             t.scale = glm::vec3(radius * 2.0f, cylinderHeight, radius * 2.0f);
 
-            shader.SetMat4("model", t.GetModelMatrix());
-            shader.SetVec3("objectColor", glm::vec3(0.48f, 0.99f, 0.0f));
-            shader.SetBool("useVertexColor", false);
+            shader.SetMat4(modelUniform, t.GetModelMatrix());
+            shader.SetVec3(objectColorUniform, glm::vec3(0.48f, 0.99f, 0.0f));
+            shader.SetBool(useVertexColorUniform, false);
             cube.Draw();
 
             // ---- Bottom sphere
             t.position = position + glm::vec3(0.0f, radius, 0.0f);
             t.scale = glm::vec3(radius * 2.0f);
-            shader.SetMat4("model", t.GetModelMatrix());
+            shader.SetMat4(modelUniform, t.GetModelMatrix());
             cube.Draw();
 
             // ---- Top sphere
             t.position = position + glm::vec3(0.0f, radius + cylinderHeight, 0.0f);
-            shader.SetMat4("model", t.GetModelMatrix());
+            shader.SetMat4(modelUniform, t.GetModelMatrix());
             cube.Draw();
 
             glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
@@ -472,9 +578,358 @@ static void RunGameLoop(GLFWwindow* window)
     bool wasCtrlTDown = false;
     bool wasCtrlCDown = false;
     bool wasCtrlPDown = false;
+    bool wasCtrlGDown = false;
+    bool wasCtrlIDown = false;
+    bool wasCtrlHDown = false;
+    bool wasCtrlNDown = false;
+    bool wasCtrlFDown = false;
+    bool wasCtrlODown = false;
+    bool wasCtrlRDown = false;
+    bool wasCtrlVDown = false;
+    bool wasCtrlLDown = false;
+
+    bool verifyRenderPaths = options.verifyGpuDriven;
+    bool printSystemTimeline = false;
+
+    // Rajzolás terhelési teszt: rács a pálya felett a scene-ben
+    for (int i = 0; i < StressCubesPerSide * StressCubesPerSide; ++i)
+    {
+        const int x = i % StressCubesPerSide;
+        const int z = i / StressCubesPerSide;
+        const float spacing = ArenaSize / StressCubesPerSide;
+
+        Transform transform;
+        transform.position = glm::vec3(
+            (x + 0.5f) * spacing - ArenaSize * 0.5f,
+            3.0f,
+            (z + 0.5f) * spacing - ArenaSize * 0.5f);
+        transform.scale = glm::vec3(spacing * 0.5f);
+
+        Renderable renderable;
+        renderable.color = glm::vec3(x / static_cast<float>(StressCubesPerSide), 0.4f, z / static_cast<float>(StressCubesPerSide));
+
+        scene.Create(transform, PreviousTransform{ transform }, renderable);
+    }
+
+    bool showStressCubes = false;
+    bool useInstancing = true;
+    bool useFrustumCulling = true;
+    bool useOcclusionCulling = true;
+
+    double renderReportTime = 0.0;
+    double renderCpuMilliseconds = 0.0;
+    int renderFrameCount = 0;
+    int frameDrawCalls = 0;
+
+#endif
+
+#ifdef ENGINE_BENCHMARKS
+    bool wasCtrlBDown = false;
+    bool wasCtrlMDown = false;
+    bool wasCtrlEDown = false;
+    bool wasCtrlJDown = false;
+#endif
+
+    // ---- Systems ----
+    // a rendszerek között átadott, képkockánként újraszámolt állapot
+    int simulationSteps = 0;
+    glm::mat4 view(1.0f);
+    glm::mat4 projection(1.0f);
+
+#ifdef ENGINE_DEBUG
+    std::size_t frustumCulledCount = 0;
+    std::size_t occludedCount = 0;
+#endif
+
+    // Az olvasott és írt adatok alapján a nem ütköző rendszerek párhuzamosan
+    // futnak, az ütközők a hozzáadás sorrendjében. Az ütközési lekérdezés nem
+    // csak olvas: a rács lekérdezési bélyegeit és az entitások doboz cache-ét
+    // is írja, ezért aki lekérdez, a world-öt és a worldEntities-t is írja.
+    SystemScheduler systems(jobs);
+
+    systems.Add("camera input", SystemAccess().Write(&camera).MainThread(), [&]()
+    {
+        camera.Update();
+    });
+
+    systems.Add("simulation", SystemAccess().Read(&camera).Write(&worldEntities).Write(&world).MainThread(), [&]()
+    {
+        for (int step = 0; step < simulationSteps; ++step)
+        {
+            const float stepDeltaTime = timestep.GetStepDeltaTime();
+
+            for (Entity* entity : worldEntities)
+            {
+                entity->previousTransform = entity->transform;
+            }
+
+            PlayerMovement(player, playerController, world, camera, playerMovementSpeed, stepDeltaTime);
+            world.Update(&player);
+
+            centerCube.transform.rotationDegrees.y += 30.0f * stepDeltaTime;
+            world.Update(&centerCube);
+        }
+    });
+
+    systems.Add("camera follow", SystemAccess().Write(&worldEntities).Write(&world).Write(&camera).Write(&smoothedCameraDistance).Write(&view).Write(&projection), [&]()
+    {
+        const Transform playerRenderTransform = InterpolateTransform(player.previousTransform, player.transform, interpolationAlpha);
+
+        glm::vec3 pivot =
+            playerRenderTransform.position +
+            player.collision.localOffset +
+            glm::vec3(0.0f, player.collision.capsule.height * 0.5f, 0.0f);
+
+        glm::vec3 desiredPosition = camera.ComputeDesiredPosition(pivot, cameraDistance, CameraHeight, MinDegree, MaxDegree);
+
+        // Collision → zoom-in
+        glm::vec3 finalPosition = ResolveCameraCollision(pivot, desiredPosition, CameraRadius, world);
 
+        // Zoom-out simítása
+        glm::vec3 toDesired = desiredPosition - pivot;
+        float desiredLength = glm::length(toDesired);
+
+        if (desiredLength > 0.0001f)
+        {
+            smoothedCameraDistance = SmoothCameraDistance(
+                smoothedCameraDistance,
+                glm::length(finalPosition - pivot),
+                CameraZoomOutSpeed,
+                Time::GetDeltaTime());
+
+            finalPosition = pivot + toDesired * (smoothedCameraDistance / desiredLength);
+        }
+
+        camera.SetPosition(finalPosition);
+
+        view = camera.GetViewMatrix();
+
+        projection =
+            glm::perspective(
+                glm::radians(FieldOfViewDegrees),
+                aspectRatio,
+                NearClippingPlane,
+                FarClippingPlane
+            );
+    });
+
+    // ---- Render candidates ----
+    // a jelenet csak a saját oszlopait olvassa, így a szimulációval együtt futhat
+    systems.Add("scene extract", SystemAccess().ReadComponents<PreviousTransform, Transform, Renderable>().Write(&renderCandidates).Write(&renderModels).Write(&renderBounds), [&]()
+    {
+        renderCandidates.clear();
+        renderModels.clear();
+        renderBounds.Clear();
+
+#ifdef ENGINE_DEBUG
+        if (!showStressCubes)
+            return;
 #endif
 
+        // az oszlopokat darabolva, párhuzamosan írjuk a már lefoglalt helyekre
+        scene.ForEachChunk<PreviousTransform, Transform, Renderable>([&](std::size_t count, const PreviousTransform* previous, const Transform* transforms, const Renderable* renderables)
+        {
+            const std::size_t base = renderCandidates.size();
+
+            renderCandidates.resize(base + count);
+            renderModels.resize(base + count);
+            renderBounds.Resize(base + count);
+
+            jobs.ParallelFor(count, RenderExtractGrainSize, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    const glm::mat4 model = InterpolateTransform(previous[i].transform, transforms[i], interpolationAlpha).GetModelMatrix();
+
+                    renderCandidates[base + i] = renderables[i];
+                    renderModels[base + i] = model;
+                    renderBounds.Set(base + i, ComputeUnitCubeBounds(model));
+                }
+            });
+        });
+    });
+
+    systems.Add("world extract", SystemAccess().Read(&worldEntities).Write(&renderCandidates).Write(&renderModels).Write(&renderBounds), [&]()
+    {
+        auto AddEntity = [&](const Entity& entity)
+        {
+            glm::mat4 model = InterpolateTransform(entity.previousTransform, entity.transform, interpolationAlpha).GetModelMatrix();
+
+            renderCandidates.push_back({ entity.color, entity.useVertexColor });
+            renderModels.push_back(model);
+            renderBounds.Add(ComputeUnitCubeBounds(model));
+        };
+
+#ifdef ENGINE_DEBUG
+
+        if (!showWorld)
+        {
+            AddEntity(player);
+            return;
+        }
+
+#endif
+
+        for (const Entity* entity : worldEntities)
+        {
+            AddEntity(*entity);
+        }
+    });
+
+    // a statikus dobozok tömbjeit olvassa, ütközési lekérdezést nem futtat
+    SystemAccess cullingAccess = SystemAccess().Read(&renderCandidates).Read(&renderBounds).Read(&view).Read(&projection).Read(&world).Write(&visibleIndices).Write(&occlusionBuffer).Write(&visibleOccluders);
+
+#ifdef ENGINE_DEBUG
+    cullingAccess.Write(&frustumCulledCount).Write(&occludedCount);
+#endif
+
+    systems.Add("culling", cullingAccess, [&]()
+    {
+        // ---- Frustum culling ----
+
+        const Frustum frustum = ExtractFrustum(projection * view);
+        CullAABBs(frustum, renderBounds, visibleIndices);
+
+        // ---- Occlusion culling ----
+#ifdef ENGINE_DEBUG
+        frustumCulledCount = renderCandidates.size() - visibleIndices.size();
+        occludedCount = visibleIndices.size();
+
+        if (useOcclusionCulling)
+#endif
+        {
+            occlusionBuffer.Begin(projection * view);
+
+            CullAABBs(frustum, world.GetStaticBoundsSoA(), visibleOccluders);
+
+            for (std::uint32_t occluder : visibleOccluders)
+            {
+                occlusionBuffer.AddOccluder(world.GetStaticBounds()[occluder]);
+            }
+
+            occlusionBuffer.Rasterize();
+
+            auto occluded = [&](std::uint32_t index)
+            {
+                return !occlusionBuffer.IsVisible(renderBounds.Get(index));
+            };
+
+            visibleIndices.erase(std::remove_if(visibleIndices.begin(), visibleIndices.end(), occluded), visibleIndices.end());
+        }
+
+#ifdef ENGINE_DEBUG
+        occludedCount -= visibleIndices.size();
+#endif
+
+#ifdef ENGINE_DEBUG
+
+        // összehasonlításhoz a culling kikapcsolható (Ctrl+F)
+        if (!useFrustumCulling)
+        {
+            frustumCulledCount = 0;
+            occludedCount = 0;
+
+            visibleIndices.resize(renderCandidates.size());
+
+            for (std::uint32_t i = 0; i < visibleIndices.size(); ++i)
+            {
+                visibleIndices[i] = i;
+            }
+        }
+
+#endif
+    });
+
+    // debug buildben az ütközési alakzatok rajzolása az entitások cache-ét is írja
+    systems.Add("draw", SystemAccess().Read(&renderCandidates).Read(&renderModels).Read(&visibleIndices).Read(&view).Read(&projection).Write(&worldEntities).MainThread(), [&]()
+    {
+        glClearColor(0.05f, 0.05f, 0.08f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        FrameUniformData frameData = { view, projection };
+        frameUniforms.Update(&frameData);
+
+#ifdef ENGINE_DEBUG
+
+        if (!useInstancing)
+        {
+            shader.Use();
+
+            for (std::uint32_t index : visibleIndices)
+            {
+                DrawEntity(renderCandidates[index], renderModels[index]);
+            }
+
+            frameDrawCalls = static_cast<int>(visibleIndices.size());
+        }
+        else
+#endif
+        {
+            DrawVisible(renderPath, view);
+
+#ifdef ENGINE_DEBUG
+            frameDrawCalls = renderQueue.GetDrawCallCount();
+#endif
+        }
+
+#ifdef ENGINE_DEBUG
+
+        // klasszikus és GPU-driven út képe ugyanarra a képkockára (Ctrl+V, --verify-gpu-driven)
+        if (verifyRenderPaths)
+        {
+            verifyRenderPaths = false;
+
+            OffscreenFramebuffer target(WindowWidth, WindowHeight);
+
+            if (!target.IsComplete())
+            {
+                std::cerr << "GPU-driven check: offscreen framebuffer is incomplete\n";
+                exitCode = 1;
+            }
+            else
+            {
+                std::vector<std::uint8_t> classicImage = target.Capture([&]() { DrawVisible(RenderPath::Classic, view); });
+                std::vector<std::uint8_t> gpuDrivenImage = target.Capture([&]() { DrawVisible(RenderPath::GpuDriven, view); });
+
+                const ImageDifference difference = CompareImages(classicImage, gpuDrivenImage);
+                const bool passed = difference.differentPixels == 0;
+
+                std::cout
+                    << "GPU-driven check: " << (passed ? "PASS" : "FAIL") << ", "
+                    << visibleIndices.size() << " entities, "
+                    << difference.differentPixels << " different pixels, "
+                    << "max channel difference " << difference.maxChannelDifference << "\n";
+
+                exitCode = passed ? 0 : 1;
+            }
+
+            if (options.verifyGpuDriven)
+                glfwSetWindowShouldClose(window, GLFW_TRUE);
+        }
+
+#endif
+
+#ifdef ENGINE_DEBUG
+
+        // a debug rétegek a nem példányosított shaderrel rajzolnak
+        shader.Use();
+
+        if (showCollision)
+        {
+            for (const Entity* entity : worldEntities)
+            {
+                DrawCollisionAABB(*entity);
+            }
+        }
+
+        if (showPlayerCapsule)
+        {
+            DrawPlayerCapsule(player);
+        }
+
+#endif
+    });
+
     glEnable(GL_DEPTH_TEST);
 
     while (glfwWindowShouldClose(window) == GLFW_FALSE)
@@ -482,8 +937,25 @@ static void RunGameLoop(GLFWwindow* window)
         Time::Update();
 
 #ifdef ENGINE_DEBUG
+        auto frameStart = std::chrono::steady_clock::now();
+#endif
+
+        // ha a GPU még olvassa a három képkockával korábbi részt, itt vár
+        frameStream.BeginFrame();
+
+        // az előző képkocka ideiglenes foglalásai egyszerre szabadulnak fel
+        frameArena.BeginFrame();
+
+#ifdef ENGINE_DEBUG
+        // a módosított shader fájlok a háttérben fordulnak, készen cserélődnek
+        shaders.UpdateHotReload();
+#endif
 
+#if defined(ENGINE_DEBUG) || defined(ENGINE_BENCHMARKS)
         bool ctrlDown = Input::IsKeyPressed(GLFW_KEY_LEFT_CONTROL) || Input::IsKeyPressed(GLFW_KEY_RIGHT_CONTROL);
+#endif
+
+#ifdef ENGINE_DEBUG
 
         bool tDown = Input::IsKeyPressed(GLFW_KEY_T);
 
@@ -516,92 +988,247 @@ static void RunGameLoop(GLFWwindow* window)
 
         wasCtrlPDown = ctrlPDown;
 
-#endif
+        // broadphase váltás: lineáris referencia -> grid -> AABB fa
+        bool gDown = Input::IsKeyPressed(GLFW_KEY_G);
+        bool ctrlGDown = ctrlDown && gDown;
 
-        if (Input::IsKeyPressed(GLFW_KEY_ESCAPE))
+        if (ctrlGDown && !wasCtrlGDown)
         {
-            glfwSetWindowShouldClose(window, GLFW_TRUE);
+            switch (world.GetBroadphaseMode())
+            {
+            case BroadphaseMode::LinearScan:
+                world.SetBroadphaseMode(BroadphaseMode::SpatialHashGrid);
+                std::cout << "Broadphase: spatial hash grid\n";
+                break;
+            case BroadphaseMode::SpatialHashGrid:
+                world.SetBroadphaseMode(BroadphaseMode::AabbTree);
+                std::cout << "Broadphase: AABB tree\n";
+                break;
+            case BroadphaseMode::AabbTree:
+                world.SetBroadphaseMode(BroadphaseMode::LinearScan);
+                std::cout << "Broadphase: linear scan\n";
+                break;
+            }
         }
 
-        camera.Update();
+        wasCtrlGDown = ctrlGDown;
 
-        PlayerMovement(player, worldEntities, camera, playerMovementSpeed);
+        // ütközési statisztika: utolsó képkocka és csúcsértékek
+        bool iDown = Input::IsKeyPressed(GLFW_KEY_I);
+        bool ctrlIDown = ctrlDown && iDown;
 
-        glm::vec3 pivot =
-            player.transform.position +
-            player.collision.localOffset +
-            glm::vec3(0.0f, player.collision.capsule.height * 0.5f, 0.0f);
+        if (ctrlIDown && !wasCtrlIDown)
+        {
+            CollisionStats::PrintReport();
+        }
 
-        glm::vec3 desiredPosition = camera.ComputeDesiredPosition(pivot, cameraDistance, CameraHeight, MinDegree, MaxDegree);
+        wasCtrlIDown = ctrlIDown;
 
-        // Collision → zoom-in
-        glm::vec3 finalPosition = ResolveCameraCollision(pivot, desiredPosition, CameraRadius, worldEntities);
+        // 10k kocka be/ki
+        bool hDown = Input::IsKeyPressed(GLFW_KEY_H);
+        bool ctrlHDown = ctrlDown && hDown;
 
-        camera.SetPosition(finalPosition);
+        if (ctrlHDown && !wasCtrlHDown)
+        {
+            showStressCubes = !showStressCubes;
+            std::cout << "Stress cubes: " << (showStressCubes ? "on" : "off") << "\n";
+        }
 
-        glClearColor(0.05f, 0.05f, 0.08f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        wasCtrlHDown = ctrlHDown;
 
-        shader.Use();
+        // példányosított / entitásonkénti rajzolás
+        bool nDown = Input::IsKeyPressed(GLFW_KEY_N);
+        bool ctrlNDown = ctrlDown && nDown;
 
-        glm::mat4 view = camera.GetViewMatrix();
-        
-        glm::mat4 projection =
-            glm::perspective(
-                glm::radians(FieldOfViewDegrees),
-                aspectRatio,
-                NearClippingPlane,
-                FarClippingPlane
-            );
+        if (ctrlNDown && !wasCtrlNDown)
+        {
+            useInstancing = !useInstancing;
+            std::cout << "Rendering: " << (useInstancing ? "instanced" : "per entity") << "\n";
+        }
 
-        shader.SetMat4("view", view);
-        shader.SetMat4("projection", projection);
+        wasCtrlNDown = ctrlNDown;
 
-        centerCube.transform.rotationDegrees.y += 30.0f * Time::GetDeltaTime();
+        // frustum culling be/ki
+        bool fDown = Input::IsKeyPressed(GLFW_KEY_F);
+        bool ctrlFDown = ctrlDown && fDown;
 
+        if (ctrlFDown && !wasCtrlFDown)
+        {
+            useFrustumCulling = !useFrustumCulling;
+            std::cout << "Frustum culling: " << (useFrustumCulling ? "on" : "off") << "\n";
+        }
+
+        wasCtrlFDown = ctrlFDown;
+
+        // takarásvizsgálat be/ki
+        bool oDown = Input::IsKeyPressed(GLFW_KEY_O);
+        bool ctrlODown = ctrlDown && oDown;
+
+        if (ctrlODown && !wasCtrlODown)
+        {
+            useOcclusionCulling = !useOcclusionCulling;
+            std::cout << "Occlusion culling: " << (useOcclusionCulling ? "on" : "off") << "\n";
+        }
+
+        wasCtrlODown = ctrlODown;
+
+        // rajzolási út: klasszikus vagy GPU-driven (multi-draw indirect)
+        bool rDown = Input::IsKeyPressed(GLFW_KEY_R);
+        bool ctrlRDown = ctrlDown && rDown;
+
+        if (ctrlRDown && !wasCtrlRDown)
+        {
+            renderPath = renderPath == RenderPath::Classic ? RenderPath::GpuDriven : RenderPath::Classic;
+            std::cout << "Render path: " << (renderPath == RenderPath::Classic ? "classic" : "GPU-driven") << "\n";
+        }
+
+        wasCtrlRDown = ctrlRDown;
+
+        bool vDown = Input::IsKeyPressed(GLFW_KEY_V);
+        bool ctrlVDown = ctrlDown && vDown;
+
+        if (ctrlVDown && !wasCtrlVDown)
+        {
+            verifyRenderPaths = true;
+        }
+
+        wasCtrlVDown = ctrlVDown;
+
+        bool lDown = Input::IsKeyPressed(GLFW_KEY_L);
+        bool ctrlLDown = ctrlDown && lDown;
+
+        // a következő képkocka rendszereinek idővonala
+        if (ctrlLDown && !wasCtrlLDown)
+        {
+            printSystemTimeline = true;
+        }
+
+        wasCtrlLDown = ctrlLDown;
+
+#endif
+
+#ifdef ENGINE_BENCHMARKS
+
+        bool bDown = Input::IsKeyPressed(GLFW_KEY_B);
+        bool ctrlBDown = ctrlDown && bDown;
+
+        if (ctrlBDown && !wasCtrlBDown)
+        {
+            RunCollisionBatchBenchmark();
+            RunRaycastBenchmark();
+        }
+
+        wasCtrlBDown = ctrlBDown;
+
+        // mesh optimalizálás (ACMR/ATVR, csak debug) és betöltési idő: OBJ vs. .zsm
+        bool mDown = Input::IsKeyPressed(GLFW_KEY_M);
+        bool ctrlMDown = ctrlDown && mDown;
+
+        if (ctrlMDown && !wasCtrlMDown)
+        {
 #ifdef ENGINE_DEBUG
+            RunMeshOptimizationReport(ModelDirectory);
+#endif
+            RunMeshLoadBenchmark(ModelDirectory);
+        }
+
+        wasCtrlMDown = ctrlMDown;
 
-        if (showWorld)
+        bool eDown = Input::IsKeyPressed(GLFW_KEY_E);
+        bool ctrlEDown = ctrlDown && eDown;
+
+        // ECS oszlopok vs. Entity pointerek bejárása
+        if (ctrlEDown && !wasCtrlEDown)
         {
-            for (const Entity* entity : worldEntities)
-            {
-                DrawEntity(*entity);
-            }
+            RunEcsBenchmark();
         }
-        else
+
+        wasCtrlEDown = ctrlEDown;
+
+        bool jDown = Input::IsKeyPressed(GLFW_KEY_J);
+        bool ctrlJDown = ctrlDown && jDown;
+
+        // job rendszer skálázódása 1..N szálon
+        if (ctrlJDown && !wasCtrlJDown)
         {
-            DrawEntity(player);
+            RunJobSystemBenchmark();
         }
 
-        if (showCollision)
+        wasCtrlJDown = ctrlJDown;
+
+#endif
+
+        if (Input::IsKeyPressed(GLFW_KEY_ESCAPE))
         {
-            for (const Entity* entity : worldEntities)
-            {
-                DrawCollisionAABB(*entity);
-            }
+            glfwSetWindowShouldClose(window, GLFW_TRUE);
         }
 
-        if (showPlayerCapsule)
+        // ---- Simulation ----
+        // a lépések száma és az interpoláció a rendszerek előtt dől el
+        simulationSteps = timestep.Advance(Time::GetDeltaTimeDouble());
+        interpolationAlpha = timestep.GetInterpolationAlpha();
+
+        systems.Run();
+
+#ifdef ENGINE_DEBUG
+
+        if (printSystemTimeline)
         {
-            DrawPlayerCapsule(player);
+            printSystemTimeline = false;
+            systems.PrintTimeline();
         }
 
-#else
+        CollisionStats::EndFrame();
 
-        for (const Entity* entity : worldEntities)
+        // CPU idő a képkocka elejétől a swap-ig, átlagolva
+        auto frameEnd = std::chrono::steady_clock::now();
+        renderCpuMilliseconds += std::chrono::duration<double, std::milli>(frameEnd - frameStart).count();
+        ++renderFrameCount;
+
+        if (showStressCubes && Time::GetTime() - renderReportTime >= RenderReportInterval)
         {
-            DrawEntity(*entity);
+            std::cout
+                << "Render [" << (!useInstancing ? "per entity" : renderPath == RenderPath::Classic ? "instanced" : "GPU-driven") << "]: "
+                << visibleIndices.size() << " visible, "
+                << frustumCulledCount << " frustum culled, "
+                << occludedCount << " occluded, "
+                << frameDrawCalls << " draw calls, "
+                << frameStream.GetFrameUsage() / 1024 << " KB streamed, "
+                << frameArena.GetHighWaterMark() / 1024 << "/" << frameArena.GetBytesPerThread() / 1024 << " KB arena peak, "
+                << renderCpuMilliseconds / renderFrameCount << " ms CPU/frame\n";
+
+            renderReportTime = Time::GetTime();
+            renderCpuMilliseconds = 0.0;
+            renderFrameCount = 0;
+        }
+        else if (!showStressCubes)
+        {
+            renderCpuMilliseconds = 0.0;
+            renderFrameCount = 0;
         }
 
 #endif
 
+        // a képkocka alatt kért törlések, a rendszerek bejárása után
+        scene.FlushDestroyed();
+
+        frameStream.EndFrame();
+
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
+
+    return exitCode;
 }
 
-int main()
+int main(int argc, char** argv)
 {
+    LaunchOptions options;
+    if (!ParseLaunchOptions(argc, argv, options))
+    {
+        return -1;
+    }
+
     if (!InitializeGlfw())
     {
         return -1;
@@ -623,10 +1250,10 @@ int main()
 
     glViewport(0, 0, WindowWidth, WindowHeight);
 
-    RunGameLoop(window);
+    const int exitCode = RunGameLoop(window, options);
 
     glfwDestroyWindow(window);
     glfwTerminate();
 
-    return 0;
+    return exitCode;
 }
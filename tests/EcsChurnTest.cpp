@@ -0,0 +1,130 @@
+// ECS churn teszt: a slot-map és az archetípus oszlopok bemelegedés után
+// nem foglalhatnak a heapen, és a törölt entitások handle-jei a slotok
+// újrahasznosítása után is halottak maradnak.
+//
+// Zombihullámok mintája: minden körben ChurnEntityCount entitás születik,
+// a negyedük elveszti az ütköző komponensét (archetípusváltás), majd egy
+// rendszer mind törli. Külön futtatható, mert a foglalásokat a globális
+// operator new cseréjével számolja, ami a játékba nem kerülhet.
+
+#include "CollisionShape.h"
+#include "Components.h"
+#include "Ecs.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t ChurnEntityCount = 10000;
+    constexpr int ChurnRoundCount = 50;
+    constexpr int ChurnWarmupRoundCount = 2; // ezalatt nőnek az oszlopok és a slotok a csúcsméretre
+
+    std::uint64_t allocationCount = 0; // a teszt egy szálon fut
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocationCount;
+
+    if (void* memory = std::malloc(size != 0 ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+int main()
+{
+    EcsWorld world;
+
+    std::vector<EntityHandle> current;
+    std::vector<EntityHandle> previous;
+    current.reserve(ChurnEntityCount);
+    previous.reserve(ChurnEntityCount);
+
+    Transform transform;
+    Renderable renderable;
+
+    CollisionShape collision;
+    collision.type = CollisionShape::Type::AABB;
+    collision.halfExtents = glm::vec3(0.5f);
+
+    std::uint64_t allocations = 0;
+    std::size_t staleAlive = 0;
+    std::size_t countErrors = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < ChurnRoundCount; ++round)
+    {
+        const std::uint64_t allocationsBefore = allocationCount;
+
+        std::swap(current, previous);
+        current.clear();
+
+        for (std::size_t i = 0; i < ChurnEntityCount; ++i)
+        {
+            transform.position = glm::vec3(static_cast<float>(i), 0.0f, static_cast<float>(round));
+
+            if (i % 2 == 0)
+                current.push_back(world.Create(transform, PreviousTransform{ transform }, renderable, collision));
+            else
+                current.push_back(world.Create(transform, PreviousTransform{ transform }, renderable));
+        }
+
+        for (std::size_t i = 0; i < ChurnEntityCount; i += 4)
+        {
+            world.Remove<CollisionShape>(current[i]);
+        }
+
+        for (EntityHandle entity : previous)
+        {
+            staleAlive += world.IsAlive(entity) ? 1 : 0;
+        }
+
+        if (world.GetEntityCount() != ChurnEntityCount)
+            ++countErrors;
+
+        world.ForEachEntity<Transform>([&](EntityHandle entity, const Transform&)
+        {
+            world.Destroy(entity);
+        });
+
+        world.FlushDestroyed();
+
+        if (world.GetEntityCount() != 0)
+            ++countErrors;
+
+        if (round >= ChurnWarmupRoundCount)
+            allocations += allocationCount - allocationsBefore;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    const double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+
+    const bool passed = allocations == 0 && staleAlive == 0 && countErrors == 0;
+
+    std::cout
+        << "ECS churn: " << ChurnRoundCount << " rounds x " << ChurnEntityCount << " entities, "
+        << milliseconds / ChurnRoundCount << " ms/round, "
+        << allocations << " allocations after warm-up, "
+        << staleAlive << " stale handles alive, "
+        << countErrors << " wrong entity counts: "
+        << (passed ? "PASS" : "FAIL") << "\n";
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
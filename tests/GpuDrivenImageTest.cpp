@@ -0,0 +1,268 @@
+// GPU-driven képteszt: ugyanaz a jelenet a példányosított és a
+// glMultiDrawElementsIndirect úton pixelre egyező képet kell adjon.
+//
+// Ablak nélkül fut, EGL surfaceless kontextussal (Mesa: llvmpipe is), így
+// CI-ban is mehet. A mesh-ek egyike MeshData-ból, a másik .zsm fájlból kerül
+// a GpuDrivenRendererbe, a mentés után pedig a viewportnak vissza kell állnia.
+//
+//   GpuDrivenImageTest <shader könyvtár> <munkakönyvtár>
+//
+// GL 4.6 nélkül SkipExitCode-dal tér vissza (a ctest kihagyottnak veszi).
+
+#include "FrameArena.h"
+#include "GpuDrivenRenderer.h"
+#include "InstancedRenderer.h"
+#include "JobSystem.h"
+#include "Mesh.h"
+#include "MeshData.h"
+#include "MeshFile.h"
+#include "MeshOptimizer.h"
+#include "RenderQueue.h"
+#include "RenderVerification.h"
+#include "Shader.h"
+#include "ShaderLibrary.h"
+#include "StreamBuffer.h"
+#include "UniformBuffer.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr int SkipExitCode = 77;
+
+    constexpr int ImageWidth = 320;
+    constexpr int ImageHeight = 180;
+
+    constexpr std::size_t EntityCount = 500;
+    constexpr int FrameCount = 7; // több kör a stream buffer részein, mint StreamBuffer::FrameCount
+    constexpr float FarClippingPlane = 100.0f;
+
+    constexpr std::size_t StreamBufferFrameSize = 8 * 1024 * 1024;
+    constexpr std::size_t FrameArenaSize = 4 * 1024 * 1024;
+
+    // a hívó viewportja a mentés előtt, a Capture után ennek kell visszaállnia
+    constexpr GLint CallerViewport[4] = { 7, 5, 64, 48 };
+
+    struct TestEntity
+    {
+        glm::mat4 model;
+        glm::vec3 color;
+        bool useVertexColor;
+        bool capsule;
+    };
+
+    void* GetProcAddress(const char* name)
+    {
+        return reinterpret_cast<void*>(eglGetProcAddress(name));
+    }
+
+    // OpenGL 4.6 core kontextus felület nélkül; a rajzolás úgyis az OffscreenFramebufferbe megy
+    bool CreateHeadlessContext()
+    {
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+        EGLDisplay display = getPlatformDisplay
+            ? getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr)
+            : eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+        EGLint major = 0;
+        EGLint minor = 0;
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+            return false;
+
+        const EGLint configAttributes[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+        EGLConfig config = nullptr;
+        EGLint configCount = 0;
+        eglChooseConfig(display, configAttributes, &config, 1, &configCount);
+
+        if (!eglBindAPI(EGL_OPENGL_API))
+            return false;
+
+        const EGLint contextAttributes[] =
+        {
+            EGL_CONTEXT_MAJOR_VERSION, 4,
+            EGL_CONTEXT_MINOR_VERSION, 6,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+
+        EGLContext context = eglCreateContext(display, configCount > 0 ? config : nullptr, EGL_NO_CONTEXT, contextAttributes);
+        if (context == EGL_NO_CONTEXT)
+            return false;
+
+        return eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context) == EGL_TRUE;
+    }
+
+    bool ViewportIs(const GLint (&expected)[4])
+    {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
+        return viewport[0] == expected[0] && viewport[1] == expected[1]
+            && viewport[2] == expected[2] && viewport[3] == expected[3];
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: GpuDrivenImageTest <shader directory> <work directory>\n";
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path workDirectory = argv[2];
+
+    if (!CreateHeadlessContext() || !gladLoadGLLoader(reinterpret_cast<GLADloadproc>(GetProcAddress)) || !GLAD_GL_VERSION_4_6)
+    {
+        std::cout << "GPU-driven image test: no headless OpenGL 4.6 context, skipped\n";
+        return SkipExitCode;
+    }
+
+    JobSystem jobs;
+
+    ShaderLibrary shaders(jobs, argv[1], (workDirectory / "shader_cache").string());
+    Shader& instancedShader = shaders.Load("instanced.vert", "instanced.frag");
+    Shader& gpuDrivenShader = shaders.Load("gpu_driven.vert", "instanced.frag");
+
+    if (!shaders.Finish())
+        return EXIT_FAILURE;
+
+    StreamBuffer frameStream(StreamBufferFrameSize);
+    UniformBuffer frameUniforms(frameStream, sizeof(FrameUniformData), FrameUniformBinding);
+    instancedShader.BindUniformBlock(FrameUniformBlockName, FrameUniformBinding);
+    gpuDrivenShader.BindUniformBlock(FrameUniformBlockName, FrameUniformBinding);
+
+    // a kocka MeshData-ból, a kapszula a .zsm úton kerül a közös bufferekbe
+    MeshData cubeData = MakeCubeMeshData();
+    OptimizeMesh(cubeData);
+    Mesh cubeMesh(cubeData);
+
+    MeshData capsuleData = MakeCapsuleMeshData(0.3f, 1.8f, 16, 8, { 0.3f, 0.8f, 0.3f });
+    OptimizeMesh(capsuleData);
+
+    const std::string capsulePath = (workDirectory / "capsule.zsm").string();
+    MeshFile capsuleFile;
+
+    if (!WriteMeshFile(capsulePath, capsuleData) || !capsuleFile.Open(capsulePath))
+        return EXIT_FAILURE;
+
+    Mesh capsuleMesh(capsuleFile);
+
+    FrameArena frameArena(jobs, FrameArenaSize);
+    RenderQueue renderQueue(jobs, frameArena);
+    InstancedRenderer instancedRenderer(frameStream);
+    GpuDrivenRenderer gpuRenderer(frameStream);
+
+    const std::uint32_t instancedShaderId = renderQueue.RegisterShader(instancedShader);
+    const std::uint32_t gpuDrivenShaderId = renderQueue.RegisterShader(gpuDrivenShader);
+    const std::uint32_t cubeMeshId = renderQueue.RegisterMesh(cubeMesh);
+    const std::uint32_t capsuleMeshId = renderQueue.RegisterMesh(capsuleMesh);
+
+    gpuRenderer.AddMesh(cubeMeshId, cubeData);
+
+    if (!gpuRenderer.AddMesh(capsuleMeshId, capsuleFile))
+        return EXIT_FAILURE;
+
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 6.0f, 14.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 projection = glm::perspective(glm::radians(70.0f), static_cast<float>(ImageWidth) / ImageHeight, 0.1f, FarClippingPlane);
+    const FrameUniformData frameData{ view, projection };
+
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> coordinate(-8.0f, 8.0f);
+    std::vector<TestEntity> entities;
+
+    for (std::size_t i = 0; i < EntityCount; ++i)
+    {
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), { coordinate(random), coordinate(random) * 0.3f, coordinate(random) });
+        model = glm::rotate(model, coordinate(random), glm::vec3(0.3f, 1.0f, 0.2f));
+
+        entities.push_back({ model, { coordinate(random) / 16.0f + 0.5f, 0.4f, 0.6f }, i % 3 == 0, i % 4 == 0 });
+    }
+
+    auto Draw = [&](bool gpuDriven)
+    {
+        const std::uint32_t shaderId = gpuDriven ? gpuDrivenShaderId : instancedShaderId;
+
+        renderQueue.Begin();
+
+        renderQueue.Build(entities.size(), [&](std::size_t first, std::size_t last, RenderCommandList& commands)
+        {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                const TestEntity& entity = entities[i];
+                const float viewDepth = -(view * entity.model[3]).z;
+                const std::uint32_t meshId = entity.capsule ? capsuleMeshId : cubeMeshId;
+
+                commands.Add(MakeSortKey(RenderPass::Opaque, shaderId, meshId, 0, viewDepth / FarClippingPlane), entity.model, entity.color, entity.useVertexColor);
+            }
+        });
+
+        if (gpuDriven)
+        {
+            renderQueue.ExecuteIndirect(gpuRenderer);
+        }
+        else
+        {
+            renderQueue.Execute(instancedRenderer);
+        }
+    };
+
+    OffscreenFramebuffer target(ImageWidth, ImageHeight);
+
+    if (!target.IsComplete())
+    {
+        std::cerr << "GPU-driven image test: offscreen framebuffer is incomplete\n";
+        return EXIT_FAILURE;
+    }
+
+    glEnable(GL_DEPTH_TEST);
+    glClearColor(0.05f, 0.05f, 0.08f, 1.0f);
+
+    std::vector<std::uint8_t> classicImage;
+    std::vector<std::uint8_t> gpuDrivenImage;
+    bool viewportRestored = true;
+
+    for (int frame = 0; frame < FrameCount; ++frame)
+    {
+        frameStream.BeginFrame();
+        frameArena.BeginFrame();
+        frameUniforms.Update(&frameData);
+
+        glViewport(CallerViewport[0], CallerViewport[1], CallerViewport[2], CallerViewport[3]);
+
+        classicImage = target.Capture([&]() { Draw(false); });
+        gpuDrivenImage = target.Capture([&]() { Draw(true); });
+
+        viewportRestored = viewportRestored && ViewportIs(CallerViewport);
+
+        frameStream.EndFrame();
+    }
+
+    const ImageDifference difference = CompareImages(classicImage, gpuDrivenImage);
+    const GLenum error = glGetError();
+
+    const bool passed = difference.differentPixels == 0 && viewportRestored && error == GL_NO_ERROR;
+
+    std::cout
+        << "GPU-driven image test: " << EntityCount << " entities, "
+        << gpuRenderer.GetDrawCommandCount() << " indirect commands, "
+        << difference.differentPixels << " different pixels, "
+        << "max channel difference " << difference.maxChannelDifference << ", "
+        << "viewport " << (viewportRestored ? "restored" : "NOT restored") << ", "
+        << "GL error 0x" << std::hex << error << std::dec << ": "
+        << (passed ? "PASS" : "FAIL") << "\n";
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
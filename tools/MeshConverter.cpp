@@ -0,0 +1,65 @@
+// Offline mesh konverter: OBJ -> .zsm (MeshFile.h)
+//
+//   MeshConverter <input.obj> <output.zsm> [r g b]
+//
+// Deduplikál, vertex cache és fetch sorrendre optimalizál, majd a futásidőben
+// mmap-pel betölthető bináris formában írja ki. A szín a vertex színe lesz.
+
+#include "MeshData.h"
+#include "MeshFile.h"
+#include "MeshOptimizer.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv)
+{
+    if (argc != 3 && argc != 6)
+    {
+        std::cerr << "usage: MeshConverter <input.obj> <output.zsm> [r g b]\n";
+        return EXIT_FAILURE;
+    }
+
+    const std::string input = argv[1];
+    const std::string output = argv[2];
+
+    glm::vec3 color(1.0f);
+    if (argc == 6)
+    {
+        color = glm::vec3(std::strtof(argv[3], nullptr), std::strtof(argv[4], nullptr), std::strtof(argv[5], nullptr));
+    }
+
+    if (input.size() < 4 || input.compare(input.size() - 4, 4, ".obj") != 0)
+    {
+        std::cerr << "unsupported input format (only .obj): " << input << "\n";
+        return EXIT_FAILURE;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    MeshData mesh;
+    if (!LoadObjMesh(input, color, mesh))
+        return EXIT_FAILURE;
+
+    const std::size_t sourceVertexCount = mesh.vertices.size();
+    const VertexCacheStats before = AnalyzeVertexCache(mesh.indices, mesh.vertices.size());
+
+    OptimizeMesh(mesh);
+
+    const VertexCacheStats after = AnalyzeVertexCache(mesh.indices, mesh.vertices.size());
+
+    if (!WriteMeshFile(output, mesh))
+        return EXIT_FAILURE;
+
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout
+        << output << ": " << mesh.GetTriangleCount() << " tris, "
+        << sourceVertexCount << " -> " << mesh.vertices.size() << " vertices, "
+        << "ACMR " << before.acmr << " -> " << after.acmr << ", "
+        << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file